@@ -0,0 +1,212 @@
+#include "AccessControl.h"
+
+#include "FileIO.h" // syncFile, replaceFile
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+WorkStealingPool& accessControlPool() {
+    static WorkStealingPool pool;
+    return pool;
+}
+
+// === Реализация методов класса User ===
+
+User::User(const std::string& name, int id, int accessLevel)
+    : name(name), id(id), accessLevel(accessLevel)
+{
+    if (name.empty()) throw std::invalid_argument("Имя пользователя не может быть пустым.");
+    if (accessLevel < 0) throw std::invalid_argument("Уровень доступа не может быть отрицательным.");
+}
+
+bool User::checkAccessToResource(const Resource& resource) const {
+    return accessLevel >= resource.getRequiredAccessLevel();
+}
+
+void User::setName(const std::string& name) {
+    this->name = name;
+}
+
+void User::setId(int id) {
+    this->id = id;
+}
+
+void User::setAccessLevel(int level) {
+    if (level < 0) throw std::invalid_argument("Уровень доступа не может быть отрицательным.");
+    this->accessLevel = level;
+}
+
+// === Реализация методов класса Student ===
+
+Student::Student(const std::string& name, int id, int accessLevel, const std::string& group)
+    : User(name, id, accessLevel), group(group) {}
+
+void Student::displayInfo() const {
+    std::cout << "Студент: " << name << ", ID: " << id
+        << ", Группа: " << group
+        << ", Уровень доступа: " << getAccessLevel() << "\n";
+}
+
+// === Реализация методов класса Teacher ===
+
+Teacher::Teacher(const std::string& name, int id, int accessLevel, const std::string& department)
+    : User(name, id, accessLevel), department(department) {}
+
+void Teacher::displayInfo() const {
+    std::cout << "Преподаватель: " << name << ", ID: " << id
+        << ", Кафедра: " << department
+        << ", Уровень доступа: " << getAccessLevel() << "\n";
+}
+
+// === Реализация класса Administrator ===
+
+Administrator::Administrator(const std::string& name, int id, int accessLevel)
+    : User(name, id, accessLevel) {}
+
+void Administrator::displayInfo() const {
+    std::cout << "Администратор: " << name << ", ID: " << id
+        << ", Уровень доступа: " << getAccessLevel() << "\n";
+}
+
+// === Реализация методов класса Resource ===
+
+Resource::Resource(const std::string& name, int requiredAccessLevel)
+    : name(name), requiredAccessLevel(requiredAccessLevel)
+{
+    if (name.empty()) throw std::invalid_argument("Название ресурса не может быть пустым.");
+    if (requiredAccessLevel < 0) throw std::invalid_argument("Требуемый уровень доступа не может быть отрицательным.");
+}
+
+void Resource::setName(const std::string& name) {
+    if (name.empty()) throw std::invalid_argument("Название ресурса не может быть пустым.");
+    this->name = name;
+}
+
+void Resource::setRequiredAccessLevel(int level) {
+    if (level < 0) throw std::invalid_argument("Требуемый уровень доступа не может быть отрицательным.");
+    this->requiredAccessLevel = level;
+}
+
+// === Вспомогательные функции для типов пользователей ===
+
+const char* userTypeName(UserType type) {
+    switch (type) {
+    case UserType::Student: return "Student";
+    case UserType::Teacher: return "Teacher";
+    case UserType::Administrator: return "Administrator";
+    }
+    return "Unknown";
+}
+
+const std::string& getUserExtra(const User& user) {
+    static const std::string none;
+    switch (user.getType()) {
+    case UserType::Student: return static_cast<const Student&>(user).getGroup();
+    case UserType::Teacher: return static_cast<const Teacher&>(user).getDepartment();
+    default: return none;
+    }
+}
+
+std::shared_ptr<User> makeUser(UserType type, const std::string& name, int id, int accessLevel,
+                               const std::string& extra) {
+    switch (type) {
+    case UserType::Student: return std::make_shared<Student>(name, id, accessLevel, extra);
+    case UserType::Teacher: return std::make_shared<Teacher>(name, id, accessLevel, extra);
+    case UserType::Administrator: return std::make_shared<Administrator>(name, id, accessLevel);
+    }
+    throw std::runtime_error("Неизвестный тип пользователя: " + std::to_string(static_cast<uint32_t>(type)));
+}
+
+// === Реализация класса MappedFile ===
+
+MappedFile::MappedFile(const std::string& filename) {
+#ifdef _WIN32
+    std::ifstream in(filename, std::ios::binary);
+    if (!in) throw std::runtime_error("Не удалось открыть файл для чтения: " + filename);
+    buffer.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    bytes = buffer.data();
+    length = buffer.size();
+#else
+    fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) throw std::runtime_error("Не удалось открыть файл для чтения: " + filename);
+
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+        ::close(fd);
+        throw std::runtime_error("Не удалось определить размер файла: " + filename);
+    }
+    length = static_cast<size_t>(st.st_size);
+    if (length > 0) {
+        void* mapped = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapped == MAP_FAILED) {
+            ::close(fd);
+            throw std::runtime_error("Не удалось отобразить файл в память: " + filename);
+        }
+        ::madvise(mapped, length, MADV_SEQUENTIAL);
+        bytes = static_cast<const char*>(mapped);
+    }
+#endif
+}
+
+MappedFile::~MappedFile() {
+#ifndef _WIN32
+    if (bytes) ::munmap(const_cast<char*>(bytes), length);
+    if (fd >= 0) ::close(fd);
+#endif
+}
+
+// === Реализация класса AtomicFileWriter ===
+
+AtomicFileWriter::AtomicFileWriter(const std::string& filename, size_t bufferSize)
+    : filename(filename), tempFilename(filename + ".tmp")
+{
+    file = std::fopen(tempFilename.c_str(), "wb");
+    if (!file) throw std::runtime_error("Не удалось открыть файл для записи: " + tempFilename);
+    buffer.reserve(bufferSize);
+}
+
+AtomicFileWriter::~AtomicFileWriter() {
+    if (file) {
+        std::fclose(file);
+        std::remove(tempFilename.c_str());
+    }
+}
+
+void AtomicFileWriter::flushBuffer() {
+    if (!buffer.empty() && std::fwrite(buffer.data(), 1, buffer.size(), file) != buffer.size()) {
+        throw std::runtime_error("Ошибка записи в файл: " + tempFilename);
+    }
+    buffer.clear();
+}
+
+void AtomicFileWriter::write(const void* data, size_t size) {
+    const char* bytes = static_cast<const char*>(data);
+    if (buffer.size() + size > buffer.capacity()) {
+        flushBuffer();
+        if (size > buffer.capacity()) { // Крупный блок пишем напрямую
+            if (std::fwrite(bytes, 1, size, file) != size) {
+                throw std::runtime_error("Ошибка записи в файл: " + tempFilename);
+            }
+            return;
+        }
+    }
+    buffer.insert(buffer.end(), bytes, bytes + size);
+}
+
+void AtomicFileWriter::commit() {
+    flushBuffer();
+    if (!syncFile(file)) throw std::runtime_error("Ошибка записи в файл: " + tempFilename);
+    std::FILE* closing = file;
+    file = nullptr;
+    if (std::fclose(closing) != 0) {
+        std::remove(tempFilename.c_str());
+        throw std::runtime_error("Ошибка записи в файл: " + tempFilename);
+    }
+    if (!replaceFile(tempFilename, filename)) {
+        throw std::runtime_error("Не удалось переименовать " + tempFilename + " в " + filename);
+    }
+}
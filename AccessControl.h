@@ -0,0 +1,867 @@
+#pragma once
+
+// === Система контроля доступа (LB_10) ===
+// Пользователи, ресурсы, AccessControlSystem и форматы сохранения: текстовый
+// и бинарный снимок. Реализация нешаблонных частей — в AccessControl.c++.
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <memory>
+#include <algorithm>
+#include <cctype>
+#include <stdexcept>
+#include <unordered_map>
+#include <mutex>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <chrono>
+#include <charconv>
+
+#include "ThreadPool.h" // WorkStealingPool для пакетных запросов
+#include "Timing.h"     // LB_TIME_SCOPE
+
+class Resource;
+
+// Стабильный тег типа пользователя (не зависит от компилятора, в отличие от typeid)
+enum class UserType : uint32_t {
+    Student = 1,
+    Teacher = 2,
+    Administrator = 3
+};
+
+// === Вспомогательные функции ===
+
+inline std::string toLower(const std::string& str) {
+    std::string result = str;
+    std::transform(result.begin(), result.end(), result.begin(),
+        [](unsigned char c) { return std::tolower(c); });
+    return result;
+}
+
+inline std::string trim(const std::string& s) {
+    auto start = s.begin();
+    while (start != s.end() && std::isspace(*start)) ++start;
+
+    auto end = s.end();
+    do {
+        --end;
+    } while (std::distance(start, end) > 0 && std::isspace(*end));
+
+    return std::string(start, end + 1);
+}
+
+// === Текстовый формат: поля разделены табуляцией ===
+// Табуляция, перевод строки и обратная косая черта внутри поля экранируются
+// (\t, \n, \\), поэтому имена и группы могут содержать любые символы, включая пробелы.
+inline void appendField(std::string& out, const std::string& field) {
+    for (char c : field) {
+        switch (c) {
+        case '\t': out += "\\t"; break;
+        case '\n': out += "\\n"; break;
+        case '\r': out += "\\r"; break;
+        case '\\': out += "\\\\"; break;
+        default: out += c; break;
+        }
+    }
+}
+
+// Разбор строки на поля с обратным экранированием; false при неизвестной escape-последовательности
+inline bool splitFields(const std::string& line, std::vector<std::string>& fields) {
+    fields.assign(1, std::string());
+    for (size_t i = 0; i < line.size(); ++i) {
+        char c = line[i];
+        if (c == '\t') {
+            fields.emplace_back();
+        }
+        else if (c == '\\') {
+            if (++i == line.size()) return false;
+            switch (line[i]) {
+            case 't': fields.back() += '\t'; break;
+            case 'n': fields.back() += '\n'; break;
+            case 'r': fields.back() += '\r'; break;
+            case '\\': fields.back() += '\\'; break;
+            default: return false;
+            }
+        }
+        else {
+            fields.back() += c;
+        }
+    }
+    return true;
+}
+
+// Старый текстовый формат (до табуляции): поля разделены пробелами
+inline std::vector<std::string> splitWords(const std::string& line) {
+    std::istringstream in(line);
+    std::vector<std::string> words;
+    std::string word;
+    while (in >> word) words.push_back(word);
+    return words;
+}
+
+inline std::string joinWords(const std::vector<std::string>& words, size_t begin, size_t end) {
+    std::string result;
+    for (size_t i = begin; i < end; ++i) {
+        if (i > begin) result += ' ';
+        result += words[i];
+    }
+    return result;
+}
+
+// Целое число во всём поле; false, если поле не число целиком
+inline bool parseIntField(const std::string& field, int& value) {
+    const char* end = field.data() + field.size();
+    auto result = std::from_chars(field.data(), end, value);
+    return !field.empty() && result.ec == std::errc() && result.ptr == end;
+}
+
+// === Базовый класс User ===
+class User {
+protected:
+    std::string name;
+    int id;
+    int accessLevel;
+
+public:
+    User(const std::string& name, int id, int accessLevel);
+
+    virtual void displayInfo() const = 0;
+    virtual UserType getType() const = 0;
+
+    bool checkAccessToResource(const Resource& resource) const;
+
+    const std::string& getName() const { return name; }
+    int getId() const { return id; }
+    int getAccessLevel() const { return accessLevel; }
+
+    void setAccessLevel(int level);
+
+private:
+    // Имя и ID входят в индексы AccessControlSystem, поэтому меняются
+    // только через её renameUser/changeUserId
+    template<typename> friend class AccessControlSystem;
+
+    void setName(const std::string& name);
+    void setId(int id);
+};
+
+// === Класс Student ===
+class Student : public User {
+private:
+    std::string group;
+
+public:
+    Student(const std::string& name, int id, int accessLevel, const std::string& group);
+
+    void displayInfo() const override;
+    UserType getType() const override { return UserType::Student; }
+
+    const std::string& getGroup() const { return group; }
+};
+
+// === Класс Teacher ===
+class Teacher : public User {
+private:
+    std::string department;
+
+public:
+    Teacher(const std::string& name, int id, int accessLevel, const std::string& department);
+
+    void displayInfo() const override;
+    UserType getType() const override { return UserType::Teacher; }
+
+    const std::string& getDepartment() const { return department; }
+};
+
+// === Класс Administrator ===
+class Administrator : public User {
+public:
+    Administrator(const std::string& name, int id, int accessLevel);
+
+    void displayInfo() const override;
+    UserType getType() const override { return UserType::Administrator; }
+};
+
+// Название типа для текстового формата и дополнительное поле (группа / кафедра)
+const char* userTypeName(UserType type);
+const std::string& getUserExtra(const User& user);
+
+// Создание пользователя по тегу типа
+std::shared_ptr<User> makeUser(UserType type, const std::string& name, int id, int accessLevel,
+                               const std::string& extra);
+
+// === Класс Resource ===
+class Resource {
+private:
+    std::string name;
+    int requiredAccessLevel;
+
+public:
+    Resource(const std::string& name, int requiredAccessLevel);
+
+    const std::string& getName() const { return name; }
+    int getRequiredAccessLevel() const { return requiredAccessLevel; }
+
+    void setName(const std::string& name);
+    void setRequiredAccessLevel(int level);
+};
+
+// === Бинарный снимок AccessControlSystem (версия 1) ===
+// [Header][UserRecord x userCount][ResourceRecord x resourceCount][таблица строк]
+// Строки хранятся подряд в таблице строк; у пользователя за именем сразу идёт доп. поле.
+namespace snapshot {
+    const char kMagic[4] = { 'A', 'C', 'L', 'S' };
+    const uint32_t kVersion = 1;
+
+    struct Header {
+        char magic[4];
+        uint32_t version;
+        uint64_t userCount;
+        uint64_t resourceCount;
+        uint64_t stringsOffset;
+        uint64_t stringsSize;
+    };
+
+    struct UserRecord {
+        uint32_t type;
+        int32_t id;
+        int32_t accessLevel;
+        uint32_t nameLength;
+        uint32_t extraLength;
+        uint32_t reserved;
+        uint64_t stringOffset;
+    };
+
+    struct ResourceRecord {
+        int32_t requiredAccessLevel;
+        uint32_t nameLength;
+        uint64_t stringOffset;
+    };
+
+    static_assert(sizeof(Header) == 40, "Неожиданный размер заголовка снимка");
+    static_assert(sizeof(UserRecord) == 32, "Неожиданный размер записи пользователя");
+    static_assert(sizeof(ResourceRecord) == 16, "Неожиданный размер записи ресурса");
+}
+
+// === Файл, отображённый в память только для чтения ===
+class MappedFile {
+private:
+    const char* bytes = nullptr;
+    size_t length = 0;
+#ifdef _WIN32
+    std::vector<char> buffer; // Без mmap файл читается целиком
+#else
+    int fd = -1;
+#endif
+
+public:
+    explicit MappedFile(const std::string& filename);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const char* data() const { return bytes; }
+    size_t size() const { return length; }
+};
+
+// === Запись файла крупными блоками через временный файл ===
+// Данные пишутся в "<имя>.tmp"; commit() сбрасывает их на диск и атомарно
+// переименовывает файл. Без commit() временный файл удаляется.
+class AtomicFileWriter {
+private:
+    std::string filename;
+    std::string tempFilename;
+    std::FILE* file = nullptr;
+    std::vector<char> buffer;
+
+    void flushBuffer();
+
+public:
+    explicit AtomicFileWriter(const std::string& filename, size_t bufferSize = 1 << 20);
+    ~AtomicFileWriter();
+
+    AtomicFileWriter(const AtomicFileWriter&) = delete;
+    AtomicFileWriter& operator=(const AtomicFileWriter&) = delete;
+
+    void write(const void* data, size_t size);
+    void write(const std::string& str) { write(str.data(), str.size()); }
+    void commit();
+};
+
+// === Битовая матрица доступа: строки — пользователи, столбцы — ресурсы ===
+class AccessMatrix {
+private:
+    size_t rows = 0;
+    size_t cols = 0;
+    size_t wordsPerRow = 0;
+    std::vector<uint64_t> bits;
+
+public:
+    AccessMatrix() = default;
+    AccessMatrix(size_t rows, size_t cols)
+        : rows(rows), cols(cols), wordsPerRow((cols + 63) / 64), bits(rows * ((cols + 63) / 64), 0) {}
+
+    size_t userCount() const { return rows; }
+    size_t resourceCount() const { return cols; }
+
+    bool get(size_t user, size_t resource) const {
+        return (bits[user * wordsPerRow + resource / 64] >> (resource % 64)) & 1;
+    }
+
+    void set(size_t user, size_t resource) {
+        bits[user * wordsPerRow + resource / 64] |= uint64_t(1) << (resource % 64);
+    }
+};
+
+// Общий пул потоков для пакетных запросов; создаётся при первом обращении
+WorkStealingPool& accessControlPool();
+
+// Параллельный обход диапазона [0, n): каждый поток получает свой непрерывный отрезок.
+// Первый отрезок обрабатывает вызывающий поток, остальные — потоки общего пула,
+// поэтому вызывать parallelFor из задач этого же пула нельзя.
+template<typename F>
+void parallelFor(size_t n, F&& body) {
+    const size_t minPerThread = 4096;
+    WorkStealingPool& pool = accessControlPool();
+    size_t chunkCount = std::min(pool.size(), (n + minPerThread - 1) / minPerThread);
+    if (chunkCount <= 1) {
+        body(size_t(0), n);
+        return;
+    }
+
+    std::mutex doneMutex;
+    std::condition_variable doneCv;
+    size_t remaining = chunkCount - 1;
+    size_t chunk = (n + chunkCount - 1) / chunkCount;
+    for (size_t begin = chunk; begin < n; begin += chunk) {
+        size_t end = std::min(n, begin + chunk);
+        pool.submit([&, begin, end](size_t) {
+            body(begin, end);
+            std::lock_guard<std::mutex> lock(doneMutex);
+            if (--remaining == 0) doneCv.notify_one();
+        });
+    }
+    body(size_t(0), chunk);
+
+    std::unique_lock<std::mutex> lock(doneMutex);
+    doneCv.wait(lock, [&remaining] { return remaining == 0; });
+}
+
+// Запрос на проверку доступа: пользователь по ID и ресурс по названию
+struct AccessRequest {
+    int userId;
+    std::string resourceName;
+};
+
+// === Шаблонный класс AccessControlSystem ===
+// Имя и ID добавленного пользователя входят в индексы, поэтому поиск возвращает
+// shared_ptr<const T>, а менять их можно только через renameUser/changeUserId
+// (User::setName/setId закрыты и доступны лишь системе).
+template<typename T>
+class AccessControlSystem {
+private:
+    std::vector<std::shared_ptr<T>> users;
+    std::vector<Resource> resources; // В порядке добавления (для вывода)
+
+    // Индексы для поиска без линейного перебора.
+    // Пользователи индексируются по хешу имени (без копий строк); пользователи
+    // с одинаковым хешем связаны в цепочку через nextSameHash в порядке добавления,
+    // само имя сверяется при поиске.
+    struct HashChain {
+        size_t first;
+        size_t last;
+    };
+    static constexpr size_t kNoUser = static_cast<size_t>(-1);
+
+    std::unordered_map<size_t, HashChain> usersByNameHash;
+    std::vector<size_t> nextSameHash;
+    std::unordered_map<int, size_t> usersById;
+    std::unordered_map<std::string, size_t> resourcesByName;
+
+    // Ресурсы, упорядоченные по требуемому уровню доступа:
+    // доступные пользователю ресурсы — это префикс до upper_bound(его уровень)
+    std::vector<int> sortedLevels;
+    std::vector<size_t> sortedResources;
+
+    void indexUser(size_t index) {
+        const T& user = *users[index];
+        nextSameHash.push_back(kNoUser);
+        auto inserted = usersByNameHash.emplace(std::hash<std::string>()(user.getName()), HashChain{ index, index });
+        if (!inserted.second) {
+            nextSameHash[inserted.first->second.last] = index;
+            inserted.first->second.last = index;
+        }
+        usersById.emplace(user.getId(), index);
+    }
+
+    // Исключение пользователя из цепочки его хеша имени
+    void unlinkName(size_t index) {
+        auto it = usersByNameHash.find(std::hash<std::string>()(users[index]->getName()));
+        HashChain& chain = it->second;
+        size_t prev = kNoUser;
+        size_t cur = chain.first;
+        while (cur != index) {
+            prev = cur;
+            cur = nextSameHash[cur];
+        }
+        if (prev == kNoUser) chain.first = nextSameHash[index];
+        else nextSameHash[prev] = nextSameHash[index];
+        if (chain.last == index) chain.last = prev;
+        nextSameHash[index] = kNoUser;
+        if (chain.first == kNoUser) usersByNameHash.erase(it);
+    }
+
+    // Включение пользователя в цепочку хеша имени с сохранением порядка добавления
+    void linkName(size_t index) {
+        auto inserted = usersByNameHash.emplace(std::hash<std::string>()(users[index]->getName()), HashChain{ index, index });
+        if (inserted.second) return;
+        HashChain& chain = inserted.first->second;
+        if (index < chain.first) {
+            nextSameHash[index] = chain.first;
+            chain.first = index;
+            return;
+        }
+        size_t prev = chain.first;
+        while (nextSameHash[prev] != kNoUser && nextSameHash[prev] < index) prev = nextSameHash[prev];
+        nextSameHash[index] = nextSameHash[prev];
+        nextSameHash[prev] = index;
+        if (chain.last == prev) chain.last = index;
+    }
+
+    void indexResource(size_t index) {
+        const Resource& res = resources[index];
+        resourcesByName.emplace(res.getName(), index);
+        auto pos = std::upper_bound(sortedLevels.begin(), sortedLevels.end(), res.getRequiredAccessLevel());
+        sortedResources.insert(sortedResources.begin() + (pos - sortedLevels.begin()), index);
+        sortedLevels.insert(pos, res.getRequiredAccessLevel());
+    }
+
+    // Полная перестройка индексов (после загрузки из файла)
+    void rebuildIndexes() {
+        usersByNameHash.clear();
+        nextSameHash.clear();
+        usersById.clear();
+        resourcesByName.clear();
+        usersByNameHash.reserve(users.size());
+        nextSameHash.reserve(users.size());
+        usersById.reserve(users.size());
+        resourcesByName.reserve(resources.size());
+        for (size_t i = 0; i < users.size(); ++i) indexUser(i);
+
+        sortedResources.resize(resources.size());
+        for (size_t i = 0; i < resources.size(); ++i) {
+            sortedResources[i] = i;
+            resourcesByName.emplace(resources[i].getName(), i);
+        }
+        std::stable_sort(sortedResources.begin(), sortedResources.end(), [this](size_t a, size_t b) {
+            return resources[a].getRequiredAccessLevel() < resources[b].getRequiredAccessLevel();
+        });
+        sortedLevels.resize(resources.size());
+        for (size_t i = 0; i < sortedResources.size(); ++i) {
+            sortedLevels[i] = resources[sortedResources[i]].getRequiredAccessLevel();
+        }
+    }
+
+    // Количество ресурсов, доступных при данном уровне (бинарный поиск)
+    size_t reachableCount(int accessLevel) const {
+        return std::upper_bound(sortedLevels.begin(), sortedLevels.end(), accessLevel) - sortedLevels.begin();
+    }
+
+public:
+    void addUser(std::shared_ptr<T> user) {
+        users.push_back(user);
+        indexUser(users.size() - 1);
+    }
+
+    void addResource(const Resource& resource) {
+        resources.push_back(resource);
+        indexResource(resources.size() - 1);
+    }
+
+    void displayAllUsers() const {
+        std::cout << "=== Все пользователи ===\n";
+        for (const auto& user : users) {
+            user->displayInfo();
+        }
+    }
+
+    void displayResources() const {
+        std::cout << "\n=== Ресурсы ===\n";
+        for (const auto& res : resources) {
+            std::cout << "Ресурс: " << res.getName()
+                << ", Требуемый уровень доступа: " << res.getRequiredAccessLevel() << "\n";
+        }
+    }
+
+    bool checkAccess(const T& user, const std::string& resourceName) const {
+        auto it = resourcesByName.find(resourceName);
+        if (it == resourcesByName.end()) return false;
+        return user.checkAccessToResource(resources[it->second]);
+    }
+
+    std::vector<std::shared_ptr<const T>> findUserExact(const std::string& name) const {
+        std::vector<std::shared_ptr<const T>> result;
+        auto it = usersByNameHash.find(std::hash<std::string>()(name));
+        if (it != usersByNameHash.end()) {
+            for (size_t index = it->second.first; index != kNoUser; index = nextSameHash[index]) {
+                if (users[index]->getName() == name) result.push_back(users[index]);
+            }
+        }
+        return result;
+    }
+
+    std::shared_ptr<const T> findUserById(int id) const {
+        auto it = usersById.find(id);
+        if (it == usersById.end()) return nullptr;
+        return users[it->second];
+    }
+
+    // Переименование пользователя с обновлением индекса имён; false, если ID не найден
+    bool renameUser(int id, const std::string& newName) {
+        if (newName.empty()) throw std::invalid_argument("Имя пользователя не может быть пустым.");
+        auto it = usersById.find(id);
+        if (it == usersById.end()) return false;
+        size_t index = it->second;
+        unlinkName(index);
+        users[index]->setName(newName);
+        linkName(index);
+        return true;
+    }
+
+    // Смена ID пользователя; false, если старый ID не найден или новый уже занят
+    bool changeUserId(int oldId, int newId) {
+        auto it = usersById.find(oldId);
+        if (it == usersById.end() || usersById.count(newId)) return false;
+        size_t index = it->second;
+        usersById.erase(it);
+        users[index]->setId(newId);
+        usersById.emplace(newId, index);
+        return true;
+    }
+
+    // Ресурсы, доступные пользователю, в порядке возрастания требуемого уровня
+    std::vector<const Resource*> reachableResources(const T& user) const {
+        std::vector<const Resource*> result;
+        size_t count = reachableCount(user.getAccessLevel());
+        result.reserve(count);
+        for (size_t i = 0; i < count; ++i) result.push_back(&resources[sortedResources[i]]);
+        return result;
+    }
+
+    void checkAccessForResource(const T& user) const {
+        std::cout << "\n=== Доступ для пользователя \"" << user.getName() << "\" ===\n";
+        const int level = user.getAccessLevel();
+        for (const auto& res : resources) {
+            bool hasAccess = level >= res.getRequiredAccessLevel();
+            std::cout << "Ресурс: " << res.getName()
+                << " -> " << (hasAccess ? "Разрешён" : "Запрещён") << "\n";
+        }
+    }
+
+    // Пакетная проверка доступа; неизвестный пользователь или ресурс — доступ запрещён
+    std::vector<bool> checkAccessBatch(const std::vector<AccessRequest>& requests) const {
+        std::vector<char> granted(requests.size(), 0);
+        parallelFor(requests.size(), [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                auto user = usersById.find(requests[i].userId);
+                auto res = resourcesByName.find(requests[i].resourceName);
+                if (user == usersById.end() || res == resourcesByName.end()) continue;
+                granted[i] = users[user->second]->getAccessLevel()
+                    >= resources[res->second].getRequiredAccessLevel();
+            }
+        });
+        return std::vector<bool>(granted.begin(), granted.end());
+    }
+
+    // Полная матрица доступа за один проход: строки в порядке users, столбцы в порядке resources
+    AccessMatrix buildAccessMatrix() const {
+        AccessMatrix matrix(users.size(), resources.size());
+        parallelFor(users.size(), [&](size_t begin, size_t end) {
+            for (size_t u = begin; u < end; ++u) {
+                size_t count = reachableCount(users[u]->getAccessLevel());
+                for (size_t i = 0; i < count; ++i) matrix.set(u, sortedResources[i]);
+            }
+        });
+        return matrix;
+    }
+
+    void displayAccessMatrix() const {
+        AccessMatrix matrix = buildAccessMatrix();
+        std::cout << "\n=== Матрица доступа ===\n";
+        for (size_t u = 0; u < users.size(); ++u) {
+            std::cout << users[u]->getName() << ": ";
+            for (size_t r = 0; r < resources.size(); ++r) {
+                std::cout << (matrix.get(u, r) ? '+' : '-');
+            }
+            std::cout << "\n";
+        }
+    }
+
+    // Текстовый формат:
+    //   <число пользователей>
+    //   <тип>\t<имя>\t<id>\t<уровень>\t<группа/кафедра>   (у администратора доп. поле пустое)
+    //   <число ресурсов>
+    //   <название>\t<уровень>
+    void saveToFile(const std::string& filename) const {
+        LB_TIME_SCOPE("AccessControlSystem::saveToFile");
+        std::ofstream out(filename, std::ios::binary);
+        if (!out) {
+            throw std::runtime_error("Не удалось открыть файл для записи: " + filename);
+        }
+
+        std::string line;
+        out << users.size() << "\n";
+        for (const auto& user : users) {
+            line.clear();
+            line += userTypeName(user->getType());
+            line += '\t';
+            appendField(line, user->getName());
+            line += '\t';
+            line += std::to_string(user->getId());
+            line += '\t';
+            line += std::to_string(user->getAccessLevel());
+            line += '\t';
+            appendField(line, getUserExtra(*user));
+            line += '\n';
+            out << line;
+        }
+
+        out << resources.size() << "\n";
+        for (const auto& res : resources) {
+            line.clear();
+            appendField(line, res.getName());
+            line += '\t';
+            line += std::to_string(res.getRequiredAccessLevel());
+            line += '\n';
+            out << line;
+        }
+
+        if (!out.flush()) {
+            throw std::runtime_error("Ошибка записи в файл: " + filename);
+        }
+        std::cout << "Данные успешно сохранены в файл: " << filename << "\n";
+    }
+
+    // Загрузка текстового формата; при ошибке данные системы не меняются,
+    // а исключение указывает номер строки.
+    // Строки без табуляции читаются по правилам прежнего формата:
+    //   <тип> <имя> <id> <уровень> [<группа/кафедра>]
+    // где тип может быть именем из typeid (например, "7Student" или "class Student"),
+    // имя может содержать пробелы, а группа/кафедра - одно слово.
+    void loadFromFile(const std::string& filename) {
+        LB_TIME_SCOPE("AccessControlSystem::loadFromFile");
+        std::ifstream in(filename, std::ios::binary);
+        if (!in) {
+            throw std::runtime_error("Не удалось открыть файл для чтения: " + filename);
+        }
+
+        size_t lineNumber = 0;
+        std::string line;
+        std::vector<std::string> fields;
+        auto fail = [&](const std::string& what) {
+            return std::runtime_error(filename + ", строка " + std::to_string(lineNumber) + ": " + what);
+        };
+        auto nextLine = [&]() {
+            ++lineNumber;
+            if (!std::getline(in, line)) throw fail("неожиданный конец файла");
+            if (!line.empty() && line.back() == '\r') line.pop_back(); // Файл с переводами строк CRLF
+        };
+        auto readCount = [&]() {
+            nextLine();
+            int count;
+            if (!parseIntField(line, count) || count < 0) throw fail("некорректное количество записей: " + line);
+            return count;
+        };
+
+        std::vector<std::shared_ptr<T>> loadedUsers;
+        int count = readCount();
+        loadedUsers.reserve(count);
+        for (int i = 0; i < count; ++i) {
+            nextLine();
+            UserType type;
+            if (line.find('\t') == std::string::npos) {
+                std::vector<std::string> words = splitWords(line);
+                if (words.size() > 1 && (words[0] == "class" || words[0] == "struct")) {
+                    words.erase(words.begin()); // typeid(...).name() в MSVC
+                }
+                if (words.empty()) throw fail("некорректная запись пользователя: " + line);
+
+                if (words[0].find("Student") != std::string::npos) type = UserType::Student;
+                else if (words[0].find("Teacher") != std::string::npos) type = UserType::Teacher;
+                else if (words[0].find("Administrator") != std::string::npos) type = UserType::Administrator;
+                else throw fail("неизвестный тип пользователя: " + words[0]);
+
+                size_t extraCount = type == UserType::Administrator ? 0 : 1;
+                if (words.size() < 4 + extraCount) {
+                    throw fail("некорректная запись пользователя: " + line);
+                }
+                size_t levelPos = words.size() - 1 - extraCount;
+                fields.assign({ words[0], joinWords(words, 1, levelPos - 1),
+                    words[levelPos - 1], words[levelPos], extraCount ? words.back() : std::string() });
+            }
+            else {
+                if (!splitFields(line, fields) || fields.size() != 5) {
+                    throw fail("некорректная запись пользователя: " + line);
+                }
+                if (fields[0] == userTypeName(UserType::Student)) type = UserType::Student;
+                else if (fields[0] == userTypeName(UserType::Teacher)) type = UserType::Teacher;
+                else if (fields[0] == userTypeName(UserType::Administrator)) type = UserType::Administrator;
+                else throw fail("неизвестный тип пользователя: " + fields[0]);
+            }
+
+            int id, level;
+            if (!parseIntField(fields[2], id)) throw fail("некорректный ID: " + fields[2]);
+            if (!parseIntField(fields[3], level)) throw fail("некорректный уровень доступа: " + fields[3]);
+            try {
+                loadedUsers.push_back(makeUser(type, fields[1], id, level, fields[4]));
+            }
+            catch (const std::invalid_argument& e) {
+                throw fail(e.what());
+            }
+        }
+
+        std::vector<Resource> loadedResources;
+        count = readCount();
+        loadedResources.reserve(count);
+        for (int i = 0; i < count; ++i) {
+            nextLine();
+            int level;
+            if (line.find('\t') == std::string::npos) {
+                // Прежний формат: <название> <уровень>, название может содержать пробелы
+                std::vector<std::string> words = splitWords(line);
+                if (words.size() < 2) throw fail("некорректная запись ресурса: " + line);
+                fields.assign({ joinWords(words, 0, words.size() - 1), words.back() });
+            }
+            else if (!splitFields(line, fields) || fields.size() != 2) {
+                throw fail("некорректная запись ресурса: " + line);
+            }
+            if (!parseIntField(fields[1], level)) throw fail("некорректный уровень доступа: " + fields[1]);
+            try {
+                loadedResources.emplace_back(fields[0], level);
+            }
+            catch (const std::invalid_argument& e) {
+                throw fail(e.what());
+            }
+        }
+
+        users.swap(loadedUsers);
+        resources.swap(loadedResources);
+        rebuildIndexes();
+        std::cout << "Данные успешно загружены из файла: " << filename << "\n";
+    }
+
+    // Сохранение бинарного снимка (атомарно, через временный файл)
+    void saveSnapshot(const std::string& filename) const {
+        LB_TIME_SCOPE("AccessControlSystem::saveSnapshot");
+        snapshot::Header header{};
+        std::memcpy(header.magic, snapshot::kMagic, sizeof(header.magic));
+        header.version = snapshot::kVersion;
+        header.userCount = users.size();
+        header.resourceCount = resources.size();
+        header.stringsOffset = sizeof(snapshot::Header)
+            + users.size() * sizeof(snapshot::UserRecord)
+            + resources.size() * sizeof(snapshot::ResourceRecord);
+        for (const auto& user : users) {
+            header.stringsSize += user->getName().size() + getUserExtra(*user).size();
+        }
+        for (const auto& res : resources) {
+            header.stringsSize += res.getName().size();
+        }
+
+        AtomicFileWriter out(filename);
+        out.write(&header, sizeof(header));
+
+        uint64_t offset = 0;
+        for (const auto& user : users) {
+            const std::string& extra = getUserExtra(*user);
+            snapshot::UserRecord record{};
+            record.type = static_cast<uint32_t>(user->getType());
+            record.id = user->getId();
+            record.accessLevel = user->getAccessLevel();
+            record.nameLength = static_cast<uint32_t>(user->getName().size());
+            record.extraLength = static_cast<uint32_t>(extra.size());
+            record.stringOffset = offset;
+            offset += record.nameLength + record.extraLength;
+            out.write(&record, sizeof(record));
+        }
+        for (const auto& res : resources) {
+            snapshot::ResourceRecord record{};
+            record.requiredAccessLevel = res.getRequiredAccessLevel();
+            record.nameLength = static_cast<uint32_t>(res.getName().size());
+            record.stringOffset = offset;
+            offset += record.nameLength;
+            out.write(&record, sizeof(record));
+        }
+
+        for (const auto& user : users) {
+            out.write(user->getName());
+            out.write(getUserExtra(*user));
+        }
+        for (const auto& res : resources) {
+            out.write(res.getName());
+        }
+
+        out.commit();
+    }
+
+    // Загрузка бинарного снимка: файл отображается в память, записи читаются напрямую
+    void loadSnapshot(const std::string& filename) {
+        LB_TIME_SCOPE("AccessControlSystem::loadSnapshot");
+        MappedFile file(filename);
+        auto corrupted = [&filename]() {
+            return std::runtime_error("Повреждённый файл снимка: " + filename);
+        };
+
+        snapshot::Header header;
+        if (file.size() < sizeof(header)) throw corrupted();
+        std::memcpy(&header, file.data(), sizeof(header));
+        if (std::memcmp(header.magic, snapshot::kMagic, sizeof(header.magic)) != 0) throw corrupted();
+        if (header.version != snapshot::kVersion) {
+            throw std::runtime_error("Неподдерживаемая версия снимка: " + std::to_string(header.version));
+        }
+
+        const uint64_t maxRecords = file.size() / sizeof(snapshot::ResourceRecord);
+        if (header.userCount > maxRecords || header.resourceCount > maxRecords) throw corrupted();
+        const uint64_t recordsEnd = sizeof(snapshot::Header)
+            + header.userCount * sizeof(snapshot::UserRecord)
+            + header.resourceCount * sizeof(snapshot::ResourceRecord);
+        if (header.stringsOffset != recordsEnd || recordsEnd > file.size()
+            || header.stringsSize != file.size() - recordsEnd) throw corrupted();
+
+        const char* records = file.data() + sizeof(snapshot::Header);
+        const char* strings = file.data() + header.stringsOffset;
+        auto stringAt = [&](uint64_t offset, uint64_t length) {
+            if (offset > header.stringsSize || length > header.stringsSize - offset) throw corrupted();
+            return std::string(strings + offset, strings + offset + length);
+        };
+
+        std::vector<std::shared_ptr<T>> loadedUsers;
+        loadedUsers.reserve(header.userCount);
+        for (uint64_t i = 0; i < header.userCount; ++i) {
+            snapshot::UserRecord record;
+            std::memcpy(&record, records + i * sizeof(record), sizeof(record));
+            loadedUsers.push_back(makeUser(static_cast<UserType>(record.type),
+                stringAt(record.stringOffset, record.nameLength),
+                record.id, record.accessLevel,
+                stringAt(record.stringOffset + record.nameLength, record.extraLength)));
+        }
+
+        records += header.userCount * sizeof(snapshot::UserRecord);
+        std::vector<Resource> loadedResources;
+        loadedResources.reserve(header.resourceCount);
+        for (uint64_t i = 0; i < header.resourceCount; ++i) {
+            snapshot::ResourceRecord record;
+            std::memcpy(&record, records + i * sizeof(record), sizeof(record));
+            loadedResources.emplace_back(stringAt(record.stringOffset, record.nameLength), record.requiredAccessLevel);
+        }
+
+        users.swap(loadedUsers);
+        resources.swap(loadedResources);
+        rebuildIndexes();
+    }
+};
@@ -0,0 +1,72 @@
+#include "BattleSim.h"
+
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+#include "Queue.h"
+#include "ThreadPool.h"
+
+int simulateBattle(Fighter& hero, Fighter& monster) {
+    int rounds = 0;
+    while (hero.health > 0 && monster.health > 0) {
+        ++rounds;
+        monster.health -= std::max(0, hero.attack - monster.defense);
+        if (monster.health <= 0) break;
+        hero.health -= std::max(0, monster.attack - hero.defense);
+    }
+    return rounds;
+}
+
+// Состояние одного рабочего потока (выровнено, чтобы потоки не делили кэш-линию).
+// Очередь монстров у каждого потока своя: бой не трогает общих атомарных счётчиков,
+// а нагрузку между потоками выравнивает перехват партий пулом.
+struct alignas(kCacheLineSize) WorkerStats {
+    SplitMix64 rng;
+    Queue<Fighter> spawned;
+    uint64_t battles = 0;
+    uint64_t heroWins = 0;
+    uint64_t rounds = 0;
+};
+
+static void fightNext(Fighter& monster, WorkerStats& stats) {
+    Fighter hero{ 100, 50, 10 };
+    stats.rounds += simulateBattle(hero, monster);
+    stats.battles++;
+    if (hero.health > 0) stats.heroWins++;
+}
+
+SimulationResult runSimulation(uint64_t totalBattles, size_t threadCount, uint64_t seed) {
+    const uint64_t batchSize = 1024;
+    WorkStealingPool pool(threadCount);
+    std::vector<WorkerStats> stats(pool.size());
+
+    auto start = std::chrono::steady_clock::now();
+    for (uint64_t first = 0; first < totalBattles; first += batchSize) {
+        uint64_t count = std::min(batchSize, totalBattles - first);
+        pool.submit([&stats, first, count, seed](size_t worker) {
+            WorkerStats& s = stats[worker];
+            s.rng.seed(seed ^ (first * 0x9E3779B97F4A7C15ULL));
+            for (uint64_t i = 0; i < count; ++i) {
+                // В фигурных скобках аргументы вычисляются слева направо,
+                // поэтому набор монстров не зависит от компилятора
+                s.spawned.push(Fighter{ s.rng.range(50, 300), s.rng.range(20, 60), s.rng.range(0, 15) });
+            }
+            Fighter monster{};
+            while (s.spawned.try_pop(monster)) {
+                fightNext(monster, s);
+            }
+        });
+    }
+    pool.wait();
+
+    SimulationResult result;
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    result.threads = pool.size();
+    for (const auto& s : stats) {
+        result.battles += s.battles;
+        result.heroWins += s.heroWins;
+        result.rounds += s.rounds;
+    }
+    return result;
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+// === Безголовая симуляция боёв (LB_7.2) ===
+// Бои без задержек и вывода на пуле потоков с перехватом работы.
+// Реализация — в BattleSim.c++.
+
+#include <cstddef>
+#include <cstdint>
+
+// Характеристики бойца; имя для симуляции не нужно
+struct Fighter {
+    int health;
+    int attack;
+    int defense;
+};
+
+// Быстрый генератор случайных чисел (splitmix64): дёшево пересевается для каждой партии боёв
+class SplitMix64 {
+private:
+    uint64_t state;
+
+public:
+    explicit SplitMix64(uint64_t seed = 0) : state(seed) {}
+
+    void seed(uint64_t s) { state = s; }
+
+    uint64_t next() {
+        uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    // Случайное число в диапазоне [lo, hi]
+    int range(int lo, int hi) {
+        return lo + static_cast<int>(next() % static_cast<uint64_t>(hi - lo + 1));
+    }
+};
+
+// Бой без задержек и вывода; возвращает число раундов
+int simulateBattle(Fighter& hero, Fighter& monster);
+
+// Итог симуляции
+struct SimulationResult {
+    size_t threads = 0;
+    uint64_t battles = 0;
+    uint64_t heroWins = 0;
+    uint64_t rounds = 0;
+    double seconds = 0.0;
+
+    double battlesPerSecond() const {
+        return seconds > 0 ? battles / seconds : 0.0;
+    }
+};
+
+// Партия монстров генерируется в очередь рабочего потока, затем поток разбирает её боями.
+// Набор монстров определяется только seed и номером партии, поэтому итоговая
+// статистика не зависит от числа потоков и порядка выполнения задач.
+SimulationResult runSimulation(uint64_t totalBattles, size_t threadCount, uint64_t seed);
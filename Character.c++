@@ -0,0 +1,454 @@
+#include "Character.h"
+
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <cstdlib>
+#include <algorithm>
+
+#include "FileIO.h" // syncFile, replaceFile
+#include "Timing.h" // LB_TIME_SCOPE
+
+// ===== Текстовый вывод событий =====
+void formatGame(const gamelog::Event& e, std::string& out) {
+    using gamelog::appendInt;
+    switch (e.kind) {
+    case gamelog::EventKind::Attack:
+        out.append(e.actor());
+        out += " атакует ";
+        out.append(e.target());
+        if (e.flags & gamelog::kNoEffect) {
+            out += ", но без эффекта.\n";
+        }
+        else {
+            out += " и наносит ";
+            appendInt(out, e.values[0]);
+            out += " урона!\n";
+        }
+        break;
+    case gamelog::EventKind::Heal:
+        out.append(e.actor());
+        out += " восстанавливает ";
+        appendInt(out, e.values[0]);
+        out += " HP!\n";
+        break;
+    case gamelog::EventKind::Damage:
+        out.append(e.actor());
+        out += " получает урон: ";
+        appendInt(out, e.values[0]);
+        out += " HP!\n";
+        break;
+    case gamelog::EventKind::LevelUp:
+        out.append(e.actor());
+        out += " повысил уровень! Теперь уровень: ";
+        appendInt(out, e.values[0]);
+        out += '\n';
+        break;
+    case gamelog::EventKind::Spawn:
+        out += "На вас напал ";
+        out.append(e.actor());
+        out += "!\n";
+        break;
+    case gamelog::EventKind::Defeat:
+        if (e.source == kSourceMonster) {
+            out += "Вы победили ";
+            out.append(e.actor());
+            out += "!\n";
+        }
+        else {
+            out += "Вы были побеждены...\n";
+        }
+        break;
+    case gamelog::EventKind::Status:
+        out += e.source == kSourceMonster ? "Монстр: " : "Имя: ";
+        out.append(e.actor());
+        out += "\nHP: ";
+        appendInt(out, e.values[0]);
+        out += "\nАтака: ";
+        appendInt(out, e.values[1]);
+        out += "\nЗащита: ";
+        appendInt(out, e.values[2]);
+        out += '\n';
+        if (e.source == kSourceCharacter) {
+            out += "Уровень: ";
+            appendInt(out, e.values[3]);
+            out += "\nОпыт: ";
+            appendInt(out, e.values[4]);
+            out += '\n';
+        }
+        break;
+    }
+}
+
+// ===== Реализация методов класса Character =====
+void Character::attackEnemy(Monster& enemy) {
+    int damage = attack - enemy.getDefense();
+    if (damage > 0) {
+        enemy.takeDamage(damage);
+        GAME_LOG(Attack, name, enemy.getName(), { damage }, 0, kSourceCharacter);
+    }
+    else {
+        GAME_LOG(Attack, name, enemy.getName(), { 0 }, gamelog::kNoEffect, kSourceCharacter);
+    }
+}
+
+void Character::journalStats() {
+    if (journal) journal->recordStats(*this);
+}
+
+void Character::pickUpItem(const std::string& item) {
+    if (inventory.isLogging()) gamelog::flush(); // Инвентарь пишет в std::cout напрямую
+    inventory.addItem(item);
+    if (journal) journal->recordItemAdded(item);
+}
+
+bool Character::useItem(const std::string& item) {
+    if (inventory.isLogging()) gamelog::flush();
+    if (!inventory.removeItem(item)) return false;
+    if (journal) journal->recordItemRemoved(item);
+    return true;
+}
+
+void Character::writeTo(std::ostream& out) const {
+    out << name << '\n' << health << '\n' << attack << '\n'
+        << defense << '\n' << level << '\n' << experience << '\n';
+
+    // Формат файла прежний: каждый предмет на отдельной строке
+    inventory.forEachStack([&out](const std::string& item, size_t count) {
+        for (size_t i = 0; i < count; ++i) out << item << '\n';
+    });
+    out << "END_ITEMS\n";
+}
+
+void Character::readFrom(std::istream& in) {
+    std::getline(in, name);
+    in >> health >> attack >> defense >> level >> experience;
+    in.ignore();
+
+    std::string line;
+    inventory.clear();
+    while (std::getline(in, line)) {
+        if (line == "END_ITEMS") break;
+        inventory.addItemQuiet(line);
+    }
+}
+
+void Character::saveToFile(const std::string& filename) {
+    LB_TIME_SCOPE("Character::saveToFile");
+    std::ofstream file(filename);
+    if (!file.is_open()) throw std::runtime_error("Не удалось открыть файл для сохранения.");
+
+    writeTo(file);
+
+    file.close();
+    std::cout << "Прогресс успешно сохранён.\n";
+}
+
+void Character::loadFromFile(const std::string& filename) {
+    LB_TIME_SCOPE("Character::loadFromFile");
+    std::ifstream file(filename);
+    if (!file.is_open()) throw std::runtime_error("Не удалось открыть файл для загрузки.");
+
+    readFrom(file);
+
+    file.close();
+    std::cout << "Прогресс успешно загружен.\n";
+}
+
+void Character::gainExperience(int exp) {
+    experience += exp;
+    while (experience >= level * 100) {
+        experience -= level * 100;
+        level++;
+        attack += 2;
+        defense += 1;
+        GAME_LOG(LevelUp, name, {}, { level }, 0, kSourceCharacter);
+    }
+    journalStats();
+}
+
+// ===== Реализация методов класса SaveJournal =====
+uint32_t SaveJournal::checksum(const std::string& text) {
+    uint32_t hash = 2166136261u; // FNV-1a
+    for (unsigned char c : text) {
+        hash ^= c;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+std::string SaveJournal::formatRecord(const Record& record) {
+    std::ostringstream body;
+    body << record.seq << ' ' << record.kind << ' ';
+    if (record.kind == 'S') {
+        body << record.stats[0] << ' ' << record.stats[1] << ' ' << record.stats[2] << ' '
+            << record.stats[3] << ' ' << record.stats[4];
+    }
+    else {
+        body << record.item;
+    }
+    std::string text = body.str();
+    std::ostringstream line;
+    line << text << '\t' << std::hex << checksum(text) << '\n';
+    return line.str();
+}
+
+bool SaveJournal::parseRecord(const std::string& line, Record& record) {
+    size_t tab = line.rfind('\t');
+    if (tab == std::string::npos) return false;
+    std::string text = line.substr(0, tab);
+
+    uint32_t stored;
+    std::istringstream sum(line.substr(tab + 1));
+    if (!(sum >> std::hex >> stored) || stored != checksum(text)) return false;
+
+    std::istringstream in(text);
+    if (!(in >> record.seq >> record.kind)) return false;
+    if (record.kind == 'S') {
+        for (int& value : record.stats) {
+            if (!(in >> value)) return false;
+        }
+        return true;
+    }
+    if (record.kind == 'A' || record.kind == 'R') {
+        in.ignore(); // пробел перед названием предмета
+        std::getline(in, record.item);
+        return true;
+    }
+    return record.kind == 'C';
+}
+
+void SaveJournal::apply(Character& target, const Record& record) const {
+    switch (record.kind) {
+    case 'S':
+        target.health = record.stats[0];
+        target.attack = record.stats[1];
+        target.defense = record.stats[2];
+        target.level = record.stats[3];
+        target.experience = record.stats[4];
+        break;
+    case 'A':
+        target.inventory.addItemQuiet(record.item);
+        break;
+    case 'R':
+        target.inventory.removeItemQuiet(record.item);
+        break;
+    }
+}
+
+bool SaveJournal::restore(Character& character) {
+    LB_TIME_SCOPE("SaveJournal::restore");
+    std::ifstream checkpointIn(checkpointFile);
+    if (!checkpointIn.is_open()) return false;
+
+    character.readFrom(checkpointIn);
+    uint64_t checkpointSeq = 0;
+    std::string line;
+    if (std::getline(checkpointIn, line) && line.compare(0, 4, "SEQ ") == 0) {
+        checkpointSeq = std::stoull(line.substr(4));
+    }
+    uint64_t lastSeq = checkpointSeq;
+    uint64_t lastCommit = checkpointSeq;
+
+    std::ifstream journalIn(journalFile, std::ios::binary);
+    std::vector<Record> unsaved;
+    Record record;
+    while (journalIn.is_open() && std::getline(journalIn, line)) {
+        // Последняя строка без '\n' — запись, оборванная при сбое
+        if (journalIn.eof() || !parseRecord(line, record)) break;
+        if (record.seq <= checkpointSeq) continue;
+        if (record.seq != lastSeq + 1) break;
+        lastSeq = record.seq;
+        if (record.kind != 'C') {
+            unsaved.push_back(record);
+            continue;
+        }
+        for (const auto& change : unsaved) apply(character, change);
+        unsaved.clear();
+        lastCommit = record.seq;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    committedSeq = lastCommit;
+    writtenSeq = lastCommit;
+    lastJournalSeq = lastSeq;
+    nextSeq = lastCommit + 1; // Несохранённые изменения отбрасываются
+    std::cout << "Прогресс успешно загружен.\n";
+    return true;
+}
+
+void SaveJournal::openJournal(bool truncate) {
+    journalOut = std::fopen(journalFile.c_str(), truncate ? "wb" : "ab");
+    if (!journalOut) throw std::runtime_error("Не удалось открыть журнал сохранений: " + journalFile);
+}
+
+void SaveJournal::writeRecords(const std::vector<Record>& records) {
+    if (!journalOut) throw std::runtime_error("Журнал сохранений не открыт: " + journalFile);
+    std::string buffer;
+    for (const auto& record : records) buffer += formatRecord(record);
+    if (std::fwrite(buffer.data(), 1, buffer.size(), journalOut) != buffer.size()) {
+        throw std::runtime_error("Ошибка записи в журнал сохранений: " + journalFile);
+    }
+    if (!syncFile(journalOut)) {
+        throw std::runtime_error("Ошибка записи в журнал сохранений: " + journalFile);
+    }
+}
+
+void SaveJournal::writeCheckpointFile(const Character& character, uint64_t seq) const {
+    std::ostringstream text;
+    character.writeTo(text);
+    text << "SEQ " << seq << '\n';
+    const std::string data = text.str();
+
+    const std::string tempFile = checkpointFile + ".tmp";
+    std::FILE* out = std::fopen(tempFile.c_str(), "wb");
+    if (!out) throw std::runtime_error("Не удалось открыть файл для сохранения: " + tempFile);
+    bool ok = std::fwrite(data.data(), 1, data.size(), out) == data.size() && syncFile(out);
+    ok = std::fclose(out) == 0 && ok;
+    if (!ok) std::remove(tempFile.c_str());
+    if (!ok || !replaceFile(tempFile, checkpointFile)) {
+        throw std::runtime_error("Не удалось сохранить контрольную точку: " + checkpointFile);
+    }
+}
+
+void SaveJournal::writeCheckpoint() {
+    LB_TIME_SCOPE("SaveJournal::writeCheckpoint");
+    writeCheckpointFile(shadow, committedSeq);
+
+    // Сохранённое учтено в контрольной точке — журнал начинается заново
+    // с ещё не сохранённых изменений
+    if (journalOut) std::fclose(journalOut);
+    journalOut = nullptr;
+    openJournal(true);
+    if (!uncommitted.empty()) writeRecords(uncommitted);
+    recordsSinceCheckpoint = 0;
+}
+
+void SaveJournal::start(Character& character) {
+    if (writer.joinable()) return;
+    shadow = character;
+    shadow.attachJournal(nullptr);
+
+    // Начинаем с компактной контрольной точки, чтобы новые записи
+    // не оказались за возможным оборванным хвостом старого журнала
+    openJournal(false);
+    writeCheckpoint();
+
+    character.attachJournal(this);
+    writer = std::thread(&SaveJournal::writerLoop, this);
+}
+
+void SaveJournal::enqueue(Record record) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (stopping || !writerError.empty()) return;
+        record.seq = nextSeq++;
+        pending.push_back(std::move(record));
+    }
+    wakeWriter.notify_one();
+}
+
+void SaveJournal::recordStats(const Character& character) {
+    enqueue(Record{ 0, 'S', { character.health, character.attack, character.defense,
+                              character.level, character.experience }, std::string() });
+}
+
+void SaveJournal::recordItemAdded(const std::string& item) {
+    enqueue(Record{ 0, 'A', {}, item });
+}
+
+void SaveJournal::recordItemRemoved(const std::string& item) {
+    enqueue(Record{ 0, 'R', {}, item });
+}
+
+void SaveJournal::commit() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!writerError.empty()) throw std::runtime_error(writerError);
+        if (!writer.joinable() || stopping) throw std::runtime_error("Журнал сохранений не запущен.");
+    }
+    enqueue(Record{ 0, 'C', {}, std::string() });
+}
+
+void SaveJournal::flush() {
+    std::unique_lock<std::mutex> lock(mutex);
+    wakeWriter.notify_one();
+    writtenCv.wait(lock, [this] {
+        return writtenSeq + 1 >= nextSeq || !writer.joinable() || !writerError.empty();
+    });
+    if (!writerError.empty()) throw std::runtime_error(writerError);
+}
+
+void SaveJournal::close() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wakeWriter.notify_one();
+    if (writer.joinable()) writer.join();
+    if (journalOut) {
+        std::fclose(journalOut);
+        journalOut = nullptr;
+    }
+
+    std::string error;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        error.swap(writerError); // Ошибка сообщается один раз
+    }
+    if (!error.empty()) throw std::runtime_error(error);
+}
+
+void SaveJournal::saveDirect(const Character& character) {
+    LB_TIME_SCOPE("SaveJournal::saveDirect");
+    uint64_t seq;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (writer.joinable() && writerError.empty() && !stopping) {
+            throw std::logic_error("saveDirect() при работающем журнале сохранений.");
+        }
+        seq = std::max(lastJournalSeq, nextSeq - 1);
+    }
+    writeCheckpointFile(character, seq);
+}
+
+void SaveJournal::writerLoop() {
+    std::vector<Record> batch;
+    std::unique_lock<std::mutex> lock(mutex);
+    for (;;) {
+        wakeWriter.wait(lock, [this] { return stopping || !pending.empty(); });
+        batch.swap(pending);
+        bool stop = stopping;
+        lock.unlock();
+
+        try {
+            if (!batch.empty()) {
+                writeRecords(batch);
+                for (auto& record : batch) {
+                    if (record.kind != 'C') {
+                        uncommitted.push_back(std::move(record));
+                        continue;
+                    }
+                    for (const auto& change : uncommitted) apply(shadow, change);
+                    recordsSinceCheckpoint += uncommitted.size() + 1;
+                    uncommitted.clear();
+                    committedSeq = record.seq;
+                }
+                if (recordsSinceCheckpoint >= compactEvery) writeCheckpoint();
+            }
+            lock.lock();
+            if (!batch.empty()) writtenSeq = batch.back().seq;
+        }
+        catch (const std::exception& e) {
+            // Следующие записи оказались бы за потерянными — поток останавливается
+            lock.lock();
+            writerError = e.what();
+            pending.clear();
+            writtenCv.notify_all();
+            break;
+        }
+        batch.clear();
+        writtenCv.notify_all();
+        if (stop && pending.empty()) break;
+    }
+}
@@ -0,0 +1,261 @@
+#pragma once
+
+// === Персонаж, монстры и журнал сохранений (LB_9) ===
+// Реализация методов — в Character.c++.
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <cstdio>
+#include <cstdint>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#include "Inventory.h" // Инвентарь со стопками предметов
+#include "Log.h"       // Асинхронный журнал событий
+
+// Вид сущности в событиях журнала
+const uint8_t kSourceCharacter = 0;
+const uint8_t kSourceMonster = 1;
+
+class SaveJournal;
+
+// ===== Класс Персонаж =====
+class Character {
+private:
+    std::string name;
+    int health;
+    int attack;
+    int defense;
+    int level;
+    int experience;
+    SaveJournal* journal = nullptr; // Журнал изменений (если подключён)
+
+    void journalStats();
+
+    friend class SaveJournal;
+
+public:
+    Inventory<std::string> inventory;
+
+    Character(const std::string& n = "Герой", int h = 100, int a = 10, int d = 5)
+        : name(n), health(h), attack(a), defense(d), level(1), experience(0) {}
+
+    void attackEnemy(class Monster& enemy);
+
+    void heal(int amount) {
+        health += amount;
+        if (health > 100) health = 100;
+        journalStats();
+        if (amount > 0) {
+            GAME_LOG(Heal, name, {}, { amount, health }, 0, kSourceCharacter);
+        }
+        else {
+            GAME_LOG(Damage, name, {}, { -amount, health }, 0, kSourceCharacter);
+        }
+    }
+
+    void gainExperience(int exp);
+
+    // Изменение инвентаря с записью в журнал
+    void pickUpItem(const std::string& item);
+    bool useItem(const std::string& item);
+
+    void displayInfo() const {
+        GAME_LOG(Status, name, {}, { health, attack, defense, level, experience }, 0, kSourceCharacter);
+        gamelog::flush(); // Инвентарь выводится напрямую
+        inventory.displayItems();
+    }
+
+    bool isAlive() const { return health > 0; }
+    int getHealth() const { return health; }
+    const std::string& getName() const { return name; }
+    int getDefense() const { return defense; }
+
+    void attachJournal(SaveJournal* j) { journal = j; }
+
+    // Полное состояние в текстовом формате save.txt
+    void writeTo(std::ostream& out) const;
+    void readFrom(std::istream& in);
+
+    void saveToFile(const std::string& filename);
+    void loadFromFile(const std::string& filename);
+};
+
+// ===== Журнал сохранений =====
+// Изменения персонажа дописываются в журнал (append-only) фоновым потоком.
+// Игровой цикл только кладёт запись в очередь; фоновый поток пишет пачку записей
+// и делает fsync. Сохранение игры — это запись-метка C: при загрузке применяются
+// только изменения до последней метки, как раньше учитывалось только сохранённое.
+// Фоновый поток применяет сохранённые изменения к своей копии персонажа и раз в
+// compactEvery записей переписывает её в контрольную точку save.txt (через временный
+// файл), после чего журнал начинается заново.
+//
+// Строка журнала: "<номер> <тип> <данные>\t<контрольная сумма>".
+// Типы: S — характеристики (HP, атака, защита, уровень, опыт; пишется и при
+// повышении уровня), A/R — предмет добавлен/удалён, C — сохранение.
+// Контрольная точка хранит номер последней учтённой записи ("SEQ n" после END_ITEMS),
+// поэтому при восстановлении уже учтённые записи пропускаются, а оборванный
+// при сбое хвост журнала (нет '\n' или не сходится сумма) отбрасывается.
+//
+// Ошибка записи останавливает фоновый поток: дальнейшие изменения в журнал не
+// попадают, а commit() и close() сообщают об ошибке исключением. Если журнал
+// недоступен, игру можно сохранить напрямую через saveDirect().
+class SaveJournal {
+private:
+    struct Record {
+        uint64_t seq;
+        char kind;
+        int stats[5];
+        std::string item;
+    };
+
+    std::string checkpointFile;
+    std::string journalFile;
+    size_t compactEvery;
+
+    // Общее состояние игрового и фонового потоков (под mutex)
+    std::mutex mutex;
+    std::condition_variable wakeWriter;
+    std::condition_variable writtenCv;
+    std::vector<Record> pending;
+    uint64_t nextSeq = 1;
+    uint64_t writtenSeq = 0;
+    uint64_t lastJournalSeq = 0;      // Последний номер, найденный в журнале при восстановлении
+    bool stopping = false;
+    std::string writerError;          // Ошибка фонового потока; после неё поток остановлен
+
+    // Состояние фонового потока
+    std::thread writer;
+    std::FILE* journalOut = nullptr;
+    Character shadow;                 // Персонаж на момент последнего сохранения
+    uint64_t committedSeq = 0;        // Номер последней метки сохранения
+    std::vector<Record> uncommitted;  // Изменения после последней метки
+    size_t recordsSinceCheckpoint = 0;
+
+    void enqueue(Record record);
+    void writerLoop();
+    void apply(Character& target, const Record& record) const;
+    void writeRecords(const std::vector<Record>& records);
+    void writeCheckpoint();
+    void writeCheckpointFile(const Character& character, uint64_t seq) const;
+    void openJournal(bool truncate);
+
+    static std::string formatRecord(const Record& record);
+    static bool parseRecord(const std::string& line, Record& record);
+    static uint32_t checksum(const std::string& text);
+
+public:
+    SaveJournal(const std::string& checkpointFile, const std::string& journalFile, size_t compactEvery = 256)
+        : checkpointFile(checkpointFile), journalFile(journalFile), compactEvery(compactEvery) {}
+
+    // Ошибку записи из деструктора показать уже некому: её сообщает явный close()
+    ~SaveJournal() {
+        try {
+            close();
+        }
+        catch (const std::exception&) {
+        }
+    }
+
+    SaveJournal(const SaveJournal&) = delete;
+    SaveJournal& operator=(const SaveJournal&) = delete;
+
+    // Загрузка контрольной точки и воспроизведение журнала; false, если сохранения нет
+    bool restore(Character& character);
+
+    // Запуск фонового потока; с этого момента изменения персонажа попадают в журнал
+    void start(Character& character);
+
+    void recordStats(const Character& character);
+    void recordItemAdded(const std::string& item);
+    void recordItemRemoved(const std::string& item);
+
+    // Сохранение игры: метка в журнале, запись на диск идёт в фоне.
+    // Исключение, если журнал не запущен или фоновый поток остановлен ошибкой.
+    void commit();
+
+    // Ожидание записи на диск всех поставленных в очередь записей
+    void flush();
+
+    // Запись оставшегося и остановка фонового потока; исключение, если запись не удалась
+    void close();
+
+    // Сохранение без журнала, когда фоновый поток не запущен или остановлен ошибкой:
+    // контрольная точка пишется сразу, а её номер перекрывает все записи старого журнала
+    void saveDirect(const Character& character);
+};
+
+// ===== Базовый класс Монстр =====
+class Monster {
+protected:
+    std::string name;
+    int health;
+    int attackPower;
+    int defense;
+
+public:
+    virtual ~Monster() = default;
+
+    virtual void attack(Character& player) {
+        int baseDamage = attackPower - player.getDefense();
+        if (baseDamage > 0) {
+            player.heal(-baseDamage);
+            GAME_LOG(Attack, name, player.getName(), { baseDamage }, 0, kSourceMonster);
+        }
+        else {
+            // Добавляем случайный урон от 1 до 3, чтобы гарантировать минимум 1 урон
+            int randomDamage = rand() % 3 + 1;
+            player.heal(-randomDamage);
+            GAME_LOG(Attack, name, player.getName(), { randomDamage }, 0, kSourceMonster);
+        }
+    }
+
+    virtual void takeDamage(int damage) {
+        health -= damage;
+        if (health < 0) health = 0;
+    }
+
+    virtual bool isAlive() const { return health > 0; }
+    virtual const std::string& getName() const { return name; }
+    virtual int getDefense() const { return defense; }
+
+    virtual void displayInfo() const {
+        GAME_LOG(Status, name, {}, { health, attackPower, defense }, 0, kSourceMonster);
+    }
+};
+
+// ===== Конкретные монстры =====
+class Goblin : public Monster {
+public:
+    Goblin() {
+        name = "Гоблин";
+        health = 30;
+        attackPower = 12;
+        defense = 3;
+    }
+};
+
+class Skeleton : public Monster {
+public:
+    Skeleton() {
+        name = "Скелет";
+        health = 40;
+        attackPower = 15;
+        defense = 5;
+    }
+};
+
+class Dragon : public Monster {
+public:
+    Dragon() {
+        name = "Дракон";
+        health = 100;
+        attackPower = 20;
+        defense = 10;
+    }
+};
+
+// Форматтер журнала событий: прежние сообщения игры
+void formatGame(const gamelog::Event& e, std::string& out);
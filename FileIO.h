@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <system_error>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+// === Надёжная запись файлов ===
+
+// Сброс буферов stdio и ОС на диск; false при ошибке
+inline bool syncFile(std::FILE* file) {
+    if (std::fflush(file) != 0) return false;
+#ifdef _WIN32
+    return _commit(_fileno(file)) == 0;
+#else
+    return ::fsync(::fileno(file)) == 0;
+#endif
+}
+
+// Атомарная замена target файлом source: в любой момент на диске лежит либо
+// старый, либо новый target. std::filesystem::rename заменяет существующий
+// файл и в Windows (MoveFileExW с MOVEFILE_REPLACE_EXISTING).
+// При ошибке source удаляется и возвращается false.
+inline bool replaceFile(const std::string& source, const std::string& target) {
+    std::error_code ec;
+    std::filesystem::rename(source, target, ec);
+    if (ec) std::remove(source.c_str());
+    return !ec;
+}
@@ -0,0 +1,117 @@
+#include "GameManager.h"
+
+#include <charconv>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "Timing.h" // LB_TIME_SCOPE
+
+// Размер блока чтения и записи файлов
+const size_t kIoBlockSize = 1 << 20;
+
+// Метод для сохранения данных в файл
+void saveToFile(const GameManager<Player>& manager, const std::string& filename) {
+    LB_TIME_SCOPE("saveToFile");
+    std::FILE* file = std::fopen(filename.c_str(), "wb");
+    if (!file) {
+        throw std::runtime_error("Failed to open file for writing.");
+    }
+
+    // Один буфер на всё сохранение; сбрасывается в файл по заполнении
+    std::string buffer;
+    buffer.reserve(kIoBlockSize + 256);
+    bool ok = true;
+    manager.forEach([&](const Player& entity) {
+        entity.serialize(buffer); // Сохраняем данные о каждом персонаже
+        buffer += '\n';
+        if (buffer.size() >= kIoBlockSize) {
+            ok = ok && std::fwrite(buffer.data(), 1, buffer.size(), file) == buffer.size();
+            buffer.clear();
+        }
+    });
+    ok = ok && std::fwrite(buffer.data(), 1, buffer.size(), file) == buffer.size();
+
+    if (std::fclose(file) != 0 || !ok) {
+        throw std::runtime_error("Failed to write file.");
+    }
+}
+
+// Пропуск пробельных символов (как у operator>>)
+static const char* skipSpaces(const char* p, const char* end) {
+    while (p < end && (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r')) ++p;
+    return p;
+}
+
+// Разбор записей "имя здоровье уровень" в [begin, end); возвращает конец разобранной части
+static const char* parseRecords(GameManager<Player>& manager, const char* begin, const char* end) {
+    const char* p = skipSpaces(begin, end);
+    while (p < end) {
+        const char* nameEnd = p;
+        while (nameEnd < end && *nameEnd != ' ' && *nameEnd != '\t' && *nameEnd != '\n' && *nameEnd != '\r') ++nameEnd;
+        std::string_view name(p, nameEnd - p);
+
+        int health, level;
+        const char* field = skipSpaces(nameEnd, end);
+        auto parsedHealth = std::from_chars(field, end, health);
+        field = skipSpaces(parsedHealth.ptr, end);
+        auto parsedLevel = std::from_chars(field, end, level);
+        if (parsedHealth.ec != std::errc() || parsedLevel.ec != std::errc()) {
+            throw std::runtime_error("Malformed record in save file.");
+        }
+
+        // Загружаем данные о персонаже прямо в пул
+        manager.addEntity(name, health, level);
+        p = skipSpaces(parsedLevel.ptr, end);
+    }
+    return p;
+}
+
+// Метод для загрузки данных из файла
+void loadFromFile(GameManager<Player>& manager, const std::string& filename) {
+    LB_TIME_SCOPE("loadFromFile");
+    std::FILE* file = std::fopen(filename.c_str(), "rb");
+    if (!file) {
+        throw std::runtime_error("Failed to open file for reading.");
+    }
+
+    // Файл читается крупными блоками; неполная последняя строка блока
+    // переносится в начало буфера и дочитывается со следующим блоком
+    std::vector<char> buffer(kIoBlockSize);
+    size_t carried = 0;
+    try {
+        for (;;) {
+            if (carried == buffer.size()) buffer.resize(buffer.size() * 2); // Очень длинная строка
+            size_t read = std::fread(buffer.data() + carried, 1, buffer.size() - carried, file);
+            size_t filled = carried + read;
+            if (read == 0) {
+                parseRecords(manager, buffer.data(), buffer.data() + filled);
+                break;
+            }
+
+            const char* begin = buffer.data();
+            const char* lastNewline = nullptr;
+            for (size_t i = filled; i > 0; --i) {
+                if (begin[i - 1] == '\n') {
+                    lastNewline = begin + i - 1;
+                    break;
+                }
+            }
+            if (!lastNewline) {
+                carried = filled;
+                continue;
+            }
+
+            parseRecords(manager, begin, lastNewline + 1);
+            carried = filled - (lastNewline + 1 - begin);
+            std::memmove(buffer.data(), lastNewline + 1, carried);
+        }
+    }
+    catch (...) {
+        std::fclose(file);
+        throw;
+    }
+    std::fclose(file);
+}
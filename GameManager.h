@@ -0,0 +1,253 @@
+#pragma once
+
+// === Сущности игры и их хранение (LB_7.1) ===
+// Игроки живут в пуле объектов GameManager; сохранение и загрузка текстового
+// формата "имя здоровье уровень" — в GameManager.c++.
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <string_view>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+
+// Определение базового класса Entity
+class Entity {
+public:
+    virtual ~Entity() = default;
+    virtual std::string_view getName() const = 0;
+    virtual int getHealth() const = 0;
+    virtual int getLevel() const = 0;
+    virtual void serialize(std::string& out) const = 0; // Дописывает запись в буфер
+};
+
+// Определение класса Player
+// Игрок не владеет именем: строка должна жить не меньше самого игрока.
+// GameManager::addEntity сам копирует имя в своё хранилище строк.
+class Player final : public Entity {
+private:
+    std::string_view name;
+    int health;
+    int level;
+
+    static void appendInt(std::string& out, int value) {
+        char digits[16];
+        auto result = std::to_chars(digits, digits + sizeof(digits), value);
+        out.append(digits, result.ptr);
+    }
+
+public:
+    Player(std::string_view name, int health, int level)
+        : name(name), health(health), level(level) {}
+
+    std::string_view getName() const override { return name; }
+    int getHealth() const override { return health; }
+    int getLevel() const override { return level; }
+
+    void serialize(std::string& out) const override {
+        out.append(name.data(), name.size());
+        out += ' ';
+        appendInt(out, health);
+        out += ' ';
+        appendInt(out, level);
+    }
+};
+
+// Ссылка на объект в пуле: индекс слота и поколение.
+// После удаления объекта поколение слота меняется, и старые ссылки становятся недействительными.
+struct Handle {
+    uint32_t index;
+    uint32_t generation;
+};
+
+// === Пул объектов одного типа ===
+// Объекты лежат в блоках фиксированного размера (адреса не меняются при росте),
+// освободившиеся слоты переиспользуются. Нечётное поколение — слот занят.
+template <typename T>
+class ObjectPool {
+private:
+    static constexpr uint32_t kBlockSize = 16384;
+
+    struct Block {
+        alignas(T) unsigned char storage[kBlockSize * sizeof(T)];
+    };
+
+    std::vector<std::unique_ptr<Block>> blocks;
+    std::vector<uint32_t> generations;
+    std::vector<uint32_t> freeSlots;
+    size_t count = 0;
+
+    T* slot(uint32_t index) const {
+        return std::launder(reinterpret_cast<T*>(blocks[index / kBlockSize]->storage) + index % kBlockSize);
+    }
+
+    static bool alive(uint32_t generation) { return generation & 1; }
+
+    // Без make_unique: оно обнулило бы весь блок и сразу заняло его страницы памяти
+    static std::unique_ptr<Block> newBlock() { return std::unique_ptr<Block>(new Block); }
+
+public:
+    ObjectPool() = default;
+    ObjectPool(const ObjectPool&) = delete;
+    ObjectPool& operator=(const ObjectPool&) = delete;
+
+    ~ObjectPool() {
+        clear();
+    }
+
+    // Резервирование места под n объектов
+    void reserve(size_t n) {
+        generations.reserve(n);
+        while (blocks.size() * kBlockSize < n) blocks.push_back(newBlock());
+    }
+
+    // Создание объекта прямо в слоте пула
+    template <typename... Args>
+    Handle emplace(Args&&... args) {
+        uint32_t index;
+        if (!freeSlots.empty()) {
+            index = freeSlots.back();
+            freeSlots.pop_back();
+        }
+        else {
+            index = static_cast<uint32_t>(generations.size());
+            if (index / kBlockSize >= blocks.size()) blocks.push_back(newBlock());
+            generations.push_back(0);
+        }
+        ::new (static_cast<void*>(slot(index))) T(std::forward<Args>(args)...);
+        ++generations[index];
+        ++count;
+        return Handle{ index, generations[index] };
+    }
+
+    // Объект по ссылке или nullptr, если ссылка устарела
+    T* get(Handle handle) const {
+        if (handle.index >= generations.size() || generations[handle.index] != handle.generation) return nullptr;
+        return slot(handle.index);
+    }
+
+    bool destroy(Handle handle) {
+        T* object = get(handle);
+        if (!object) return false;
+        object->~T();
+        ++generations[handle.index];
+        freeSlots.push_back(handle.index);
+        --count;
+        return true;
+    }
+
+    // Удаление всех объектов сразу; поколения сохраняются, поэтому старые ссылки
+    // остаются недействительными
+    void clear() {
+        freeSlots.clear();
+        for (uint32_t i = 0; i < generations.size(); ++i) {
+            if (!alive(generations[i])) {
+                freeSlots.push_back(i);
+                continue;
+            }
+            if (!std::is_trivially_destructible<T>::value) slot(i)->~T();
+            ++generations[i];
+            freeSlots.push_back(i);
+        }
+        count = 0;
+    }
+
+    size_t size() const {
+        return count;
+    }
+
+    template <typename F>
+    void forEach(F&& f) const {
+        for (uint32_t i = 0; i < generations.size(); ++i) {
+            if (alive(generations[i])) f(*slot(i));
+        }
+    }
+};
+
+// === Хранилище строк крупными блоками ===
+// Строки копируются подряд в общие блоки и живут до уничтожения хранилища
+class StringArena {
+private:
+    static constexpr size_t kBlockSize = 1 << 20;
+
+    std::vector<std::unique_ptr<char[]>> blocks;
+    size_t used = kBlockSize;
+
+public:
+    std::string_view store(std::string_view str) {
+        if (str.empty()) return std::string_view(); // Текущего блока может ещё не быть
+        if (str.size() > kBlockSize / 4) {
+            // Длинную строку кладём в отдельный блок перед текущим, чтобы продолжать заполнять текущий
+            auto it = blocks.insert(blocks.end() - (blocks.empty() ? 0 : 1), std::unique_ptr<char[]>(new char[str.size()]));
+            std::memcpy(it->get(), str.data(), str.size());
+            return std::string_view(it->get(), str.size());
+        }
+        if (used + str.size() > kBlockSize) {
+            blocks.push_back(std::unique_ptr<char[]>(new char[kBlockSize])); // Без обнуления
+            used = 0;
+        }
+        char* dest = blocks.back().get() + used;
+        std::memcpy(dest, str.data(), str.size());
+        used += str.size();
+        return std::string_view(dest, str.size());
+    }
+};
+
+// Определение класса GameManager
+template <typename T>
+class GameManager {
+private:
+    ObjectPool<T> entities;
+    StringArena strings;
+
+public:
+    // Имя копируется в хранилище строк менеджера, поэтому временная строка
+    // вызывающего кода не оставит сущность с висячим именем
+    template <typename... Args>
+    Handle addEntity(std::string_view name, Args&&... args) {
+        return entities.emplace(strings.store(name), std::forward<Args>(args)...);
+    }
+
+    bool removeEntity(Handle handle) {
+        return entities.destroy(handle);
+    }
+
+    T* getEntity(Handle handle) const {
+        return entities.get(handle);
+    }
+
+    // Копия строки, которая живёт столько же, сколько менеджер
+    std::string_view storeString(std::string_view str) {
+        return strings.store(str);
+    }
+
+    void reserve(size_t n) {
+        entities.reserve(n);
+    }
+
+    size_t size() const {
+        return entities.size();
+    }
+
+    template <typename F>
+    void forEach(F&& f) const {
+        entities.forEach(std::forward<F>(f));
+    }
+
+    void displayAll() const {
+        entities.forEach([](const T& entity) {
+            std::cout << entity.getName() << " (Health: " << entity.getHealth()
+                      << ", Level: " << entity.getLevel() << ")\n";
+        });
+    }
+};
+
+// Сохранение всех игроков в файл (по записи в строке)
+void saveToFile(const GameManager<Player>& manager, const std::string& filename);
+
+// Загрузка игроков из файла в менеджер
+void loadFromFile(GameManager<Player>& manager, const std::string& filename);
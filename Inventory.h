@@ -0,0 +1,147 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <iostream>
+#include <unordered_map>
+#include <vector>
+
+// === Инвентарь со стопками предметов ===
+// Названия предметов хранятся один раз и получают компактный номер (id),
+// а инвентарь хранит стопки (id, количество). Добавление, удаление и подсчёт
+// работают за O(1) через хеш-таблицу названий и массив id -> стопка.
+// Стопки выводятся в порядке первого получения предмета.
+template<typename T>
+class Inventory {
+private:
+    struct Stack {
+        uint32_t id;
+        size_t count;
+    };
+
+    static constexpr uint32_t kNoStack = UINT32_MAX;
+
+    // id -> название; deque не перемещает элементы при добавлении,
+    // поэтому ключи idByName ссылаются прямо на эти названия, без второй копии
+    std::deque<T> names;
+    std::unordered_map<std::reference_wrapper<const T>, uint32_t, std::hash<T>, std::equal_to<T>> idByName;
+    std::vector<uint32_t> stackById;        // id -> индекс стопки
+    std::vector<Stack> stacks;              // Порядок для вывода; пустые стопки пропускаются
+    size_t total = 0;
+    bool logging;
+
+    uint32_t intern(const T& item) {
+        auto found = idByName.find(item);
+        if (found != idByName.end()) return found->second;
+        uint32_t id = static_cast<uint32_t>(names.size());
+        names.push_back(item);
+        idByName.emplace(std::cref(names.back()), id);
+        stackById.push_back(kNoStack);
+        return id;
+    }
+
+    Stack* findStack(const T& item) {
+        auto found = idByName.find(item);
+        if (found == idByName.end() || stackById[found->second] == kNoStack) return nullptr;
+        return &stacks[stackById[found->second]];
+    }
+
+    const Stack* findStack(const T& item) const {
+        return const_cast<Inventory*>(this)->findStack(item);
+    }
+
+public:
+    explicit Inventory(bool logging = true) : logging(logging) {}
+
+    // Ключи idByName ссылаются на названия своего инвентаря, поэтому копия строит индекс заново
+    Inventory(const Inventory& other)
+        : names(other.names), stackById(other.stackById), stacks(other.stacks),
+          total(other.total), logging(other.logging) {
+        idByName.reserve(names.size());
+        for (uint32_t id = 0; id < names.size(); ++id) idByName.emplace(std::cref(names[id]), id);
+    }
+
+    Inventory(Inventory&&) = default; // Элементы deque при перемещении остаются на месте
+
+    Inventory& operator=(const Inventory& other) {
+        if (this != &other) *this = Inventory(other);
+        return *this;
+    }
+
+    Inventory& operator=(Inventory&&) = default;
+
+    // Вывод сообщений о добавлении и удалении предметов
+    void setLogging(bool enabled) { logging = enabled; }
+    bool isLogging() const { return logging; }
+
+    void addItem(const T& item, size_t count = 1) {
+        if (count == 0) return;
+        addItemQuiet(item, count);
+        if (logging) std::cout << "Предмет добавлен: " << item << "\n";
+    }
+
+    bool removeItem(const T& item) {
+        bool removed = removeItemQuiet(item);
+        if (logging) {
+            if (removed) std::cout << "Предмет удалён: " << item << "\n";
+            else std::cout << "Предмет не найден в инвентаре: " << item << "\n";
+        }
+        return removed;
+    }
+
+    // То же без сообщений, независимо от setLogging (загрузка, воспроизведение журнала)
+    void addItemQuiet(const T& item, size_t count = 1) {
+        if (count == 0) return;
+        uint32_t id = intern(item);
+        if (stackById[id] == kNoStack) {
+            stackById[id] = static_cast<uint32_t>(stacks.size());
+            stacks.push_back(Stack{ id, 0 });
+        }
+        stacks[stackById[id]].count += count;
+        total += count;
+    }
+
+    bool removeItemQuiet(const T& item) {
+        Stack* stack = findStack(item);
+        if (!stack || stack->count == 0) return false;
+        stack->count--; // Пустая стопка остаётся на месте, чтобы не сдвигать остальные
+        total--;
+        return true;
+    }
+
+    size_t count(const T& item) const {
+        const Stack* stack = findStack(item);
+        return stack ? stack->count : 0;
+    }
+
+    // Общее количество предметов
+    size_t size() const {
+        return total;
+    }
+
+    // Обход непустых стопок: f(название, количество)
+    template<typename F>
+    void forEachStack(F&& f) const {
+        for (const auto& stack : stacks) {
+            if (stack.count > 0) f(names[stack.id], stack.count);
+        }
+    }
+
+    // Вывод стопок под заголовком title
+    void displayItems(const char* title = "Инвентарь:") const {
+        std::cout << title << "\n";
+        forEachStack([](const T& item, size_t count) {
+            std::cout << "- " << item;
+            if (count > 1) std::cout << " x" << count;
+            std::cout << "\n";
+        });
+    }
+
+    void clear() {
+        stacks.clear();
+        for (auto& slot : stackById) slot = kNoStack;
+        total = 0;
+    }
+};
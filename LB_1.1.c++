@@ -1,6 +1,8 @@
 #include <iostream>
 #include <string>
 
+#include "Log.h" // Асинхронный журнал событий
+
 class Character {
 private:
     std::string name;  // Приватное поле: имя персонажа
@@ -20,8 +22,7 @@ public:
 
     // Метод для вывода информации о персонаже
     void displayInfo() const {
-        std::cout << "Name: " << name << ", HP: " << health
-                  << ", Attack: " << attack << ", Defense: " << defense << std::endl;
+        GAME_LOG(Status, name, {}, { health, attack, defense });
     }
 
     // Метод для атаки другого персонажа
@@ -29,9 +30,9 @@ public:
         int damage = attack - enemy.defense;
         if (damage > 0) {
             enemy.health -= damage;
-            std::cout << name << " attacks " << enemy.name << " for " << damage << " damage!" << std::endl;
+            GAME_LOG(Attack, name, enemy.name, { damage });
         } else {
-            std::cout << name << " attacks " << enemy.name << ", but it has no effect!" << std::endl;
+            GAME_LOG(Attack, name, enemy.name, { 0 }, gamelog::kNoEffect);
         }
     }
 
@@ -41,7 +42,7 @@ public:
         if (health > 100) {
             health = 100;
         }
-        std::cout << name << " heals for " << amount << " HP. Current HP: " << health << std::endl;
+        GAME_LOG(Heal, name, {}, { amount, health });
     }
 	
     // Метод получения урона
@@ -50,7 +51,7 @@ public:
         if (health < 0) {
             health = 0;
         }
-        std::cout << name << " takes " << amount << " damage. Current HP: " << health << std::endl;
+        GAME_LOG(Damage, name, {}, { amount, health });
     }
 };
 
@@ -89,4 +90,4 @@ int main() {
     test.displayInfo();
 
     return 0;
-}
\ No newline at end of file
+}
\ No newline at end of file
@@ -1,6 +1,39 @@
 #include <iostream>
 #include <string>
 
+#include "Log.h" // Асинхронный журнал событий
+
+// Строки вывода displayInfo: каждое переопределение добавляет свою строку
+const uint8_t kLineEntity = 0;     // Name, HP
+const uint8_t kLineExperience = 1; // Experience (Player)
+const uint8_t kLineType = 2;       // Type (Enemy)
+const uint8_t kLineAbility = 3;    // Special Ability (Boss)
+
+// Форматтер журнала: прежний вывод displayInfo
+void formatInfo(const gamelog::Event& e, std::string& out) {
+    switch (e.source) {
+    case kLineEntity:
+        out += "Name: ";
+        out.append(e.actor());
+        out += ", HP: ";
+        gamelog::appendInt(out, e.values[0]);
+        break;
+    case kLineExperience:
+        out += "Experience: ";
+        gamelog::appendInt(out, e.values[0]);
+        break;
+    case kLineType:
+        out += "Type: ";
+        out.append(e.target());
+        break;
+    case kLineAbility:
+        out += "Special Ability: ";
+        out.append(e.target());
+        break;
+    }
+    out += '\n';
+}
+
 class Entity {
 protected:
     std::string name; // Защищенное поле: имя
@@ -12,7 +45,7 @@ public:
 
     // Метод для вывода информации
     virtual void displayInfo() const {
-        std::cout << "Name: " << name << ", HP: " << health << std::endl;
+        GAME_LOG(Status, name, {}, { health }, 0, kLineEntity);
     }
 
     virtual ~Entity() {}
@@ -30,7 +63,7 @@ public:
     // Переопределение метода displayInfo
     void displayInfo() const override {
         Entity::displayInfo(); // Вызов метода базового класса
-        std::cout << "Experience: " << experience << std::endl;
+        GAME_LOG(Status, name, {}, { experience }, 0, kLineExperience);
     }
 };
 
@@ -46,7 +79,7 @@ public:
     // Переопределение метода displayInfo
     void displayInfo() const override {
         Entity::displayInfo(); // Вызов метода базового класса
-        std::cout << "Type: " << type << std::endl;
+        GAME_LOG(Status, name, type, {}, 0, kLineType);
     }
 };
 
@@ -62,12 +95,14 @@ public:
      // Переопределение метода displayInfo()
      void displayInfo() const override {
         Enemy::displayInfo(); // Вызов метода Enemy
-        std::cout << "Special Ability: " << specialAbility << std::endl;
+        GAME_LOG(Status, name, specialAbility, {}, 0, kLineAbility);
     }
 };
 
 
 int main() {
+    gamelog::setFormatter(formatInfo);
+
     // Создаем объект босс
     Boss finalBoss("Dark Dragon", 500, "Dragon", "Inferno Flame");
 
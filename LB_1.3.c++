@@ -1,9 +1,47 @@
 #include <iostream>
 #include <string>
-#include <cstdlib>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
 #include <ctime>
 
+#include "Log.h" // Асинхронный журнал событий
 
+// SSE2 есть на любом x86-64, поэтому ядро векторизовано и в сборке с флагами по умолчанию
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define LB_COMBAT_SSE2
+#include <emmintrin.h>
+#endif
+
+// === Счётный генератор случайных чисел ===
+// Результат зависит только от (seed, номер удара, поток), а не от скрытого состояния rand(),
+// поэтому пакетное ядро считает удары в любом порядке и пачками. Виртуальные attack()
+// нумеруют удары общим счётчиком combatCounter и рассчитаны на один поток.
+uint32_t combatSeed = 0;    // Seed текущего боя
+uint32_t combatCounter = 0; // Номер следующего удара
+
+inline uint32_t combatHash(uint32_t seed, uint32_t counter, uint32_t stream) {
+    uint32_t x = seed ^ (counter * 0x9E3779B9u) ^ (stream * 0x85EBCA6Bu);
+    x ^= x >> 16;
+    x *= 0x7FEB352Du;
+    x ^= x >> 15;
+    x *= 0x846CA68Bu;
+    x ^= x >> 16;
+    return x;
+}
+
+// Бросок в диапазоне [0, 100), аналог rand() % 100
+inline int rollPercent(uint32_t seed, uint32_t counter, uint32_t stream) {
+    return static_cast<int>(((combatHash(seed, counter, stream) >> 16) * 100u) >> 16);
+}
+
+// Потоки бросков внутри одного удара
+const uint32_t kMainRoll = 0; // Крит персонажа / яд монстра
+const uint32_t kFireRoll = 1; // Огненный удар босса
+
+// Тип сущности для пакетной обработки ударов
+enum CombatKind { KindEntity = 0, KindCharacter = 1, KindMonster = 2, KindBoss = 3 };
 
 class Entity {
 protected:
@@ -19,31 +57,35 @@ public:
 
     int getDefense() const { return defense; }
     int getHealth() const { return health; }
+    int getAttackPower() const { return attackPower; }
+    int getMaxHealth() const { return maxHealth; }
     std::string getName() const { return name; }
     void setHealth(int h) { health = std::min(h, maxHealth); }
 
 
+    virtual CombatKind combatKind() const { return KindEntity; }
+
     // Виртуальный метод для атаки
     virtual void attack(Entity& target) {
+        combatCounter++;
         int damage = attackPower - target.defense;
         if (damage > 0) {
             target.health -= damage;
-            std::cout << name << " attacks " << target.name << " for " << damage << " damage!\n";
+            GAME_LOG(Attack, name, target.name, { damage }, 0, combatKind());
         } else {
-            std::cout << name << " attacks " << target.name << ", but it has no effect!\n";
+            GAME_LOG(Attack, name, target.name, { 0 }, gamelog::kNoEffect, combatKind());
         }
     }
 
     // Виртуальный метод для вывода информации
     virtual void displayInfo() const {
-        std::cout << "Name: " << name << ", HP: " << health
-                  << ", Attack: " << attackPower << ", Defense: " << defense << std::endl;
+        GAME_LOG(Status, name, {}, { health, attackPower, defense }, 0, combatKind());
     }
 
     // Метод heal
     virtual void heal(int amount) {
         health = std::min(health + amount, maxHealth);
-        std::cout << name << " healed for " << amount << " HP!\n";
+        GAME_LOG(Heal, name, {}, { amount, health, maxHealth }, 0, combatKind());
     }
  
 
@@ -56,26 +98,29 @@ public:
     Monster(const std::string& n, int h, int a, int d)
   : Entity(n, h, a, d) {}
 
+    CombatKind combatKind() const override { return KindMonster; }
+
     // Переопределение метода attack
     void attack(Entity& target) override {
+  uint32_t hit = combatCounter++;
   int damage = attackPower - target.getDefense();
   if (damage > 0) {
+      uint8_t flags = 0;
       // Шанс на ядовитую атаку (30%)
-      if (rand() % 100 < 30) {
+      if (rollPercent(combatSeed, hit, kMainRoll) < 30) {
           damage += 5; // Дополнительный урон от яда
-          std::cout << "Poisonous attack! ";
+          flags = gamelog::kPoison;
       }
       target.setHealth(target.getHealth()- damage);
-      std::cout << name << " attacks " << target.getName() << " for " << damage << " damage!\n";
+      GAME_LOG(Attack, name, target.getName(), { damage }, flags, combatKind());
   } else {
-      std::cout << name << " attacks " << target.getName() << ", but it has no effect!\n";
+      GAME_LOG(Attack, name, target.getName(), { 0 }, gamelog::kNoEffect, combatKind());
   }
     }
 
     // Переопределение метода displayInfo
     void displayInfo() const override {
-  std::cout << "Monster: " << name << ", HP: " << health
-                  << ", Attack: " << attackPower << ", Defense: " << defense << std::endl;
+  GAME_LOG(Status, name, {}, { health, attackPower, defense }, 0, combatKind());
     }
 };
 
@@ -87,20 +132,21 @@ public:
     Boss(const std::string& n, int h, int a, int d, const std::string& ability)
         : Monster(n, h, a, d), specialAbility(ability) {}
 
+    CombatKind combatKind() const override { return KindBoss; }
+
 // Переопределение метода attack
 void attack(Entity& target) override {
+        uint32_t hit = combatCounter;
         Monster::attack(target); // Базовая атака Monster
-        if (rand() % 100 < 25) { // 25% шанс на огненный удар
+        if (rollPercent(combatSeed, hit, kFireRoll) < 25) { // 25% шанс на огненный удар
             int fireDamage = 10;
             target.setHealth(target.getHealth()- fireDamage);
-            std::cout << specialAbility << "! " << name 
-                      << " deals additional " << fireDamage << " fire damage!\n";
+            GAME_LOG(Attack, name, specialAbility, { fireDamage }, gamelog::kSpecial, combatKind());
         }
     }
 
     void displayInfo() const override {
-        std::cout << "Boss: " << name << ", HP: " << health 
-                  << ", Ability: " << specialAbility << std::endl;
+        GAME_LOG(Status, name, specialAbility, { health, attackPower, defense }, 0, combatKind());
     }
 };
 
@@ -109,37 +155,271 @@ public:
     Character(const std::string& n, int h, int a, int d)
         : Entity(n, h, a, d) {}
 
+    CombatKind combatKind() const override { return KindCharacter; }
+
     // Переопределение метода attack
     void attack(Entity& target) override {
+        uint32_t hit = combatCounter++;
         int damage = attackPower - target.getDefense();
         if (damage > 0) {
+            uint8_t flags = 0;
             // Шанс на критический удар (20%)
-            if (rand() % 100 < 20) {
+            if (rollPercent(combatSeed, hit, kMainRoll) < 20) {
                 damage *= 2;
-                std::cout << "Critical hit! ";
+                flags = gamelog::kCritical;
             }
             target.setHealth(target.getHealth() - damage);
-            std::cout << name << " attacks " << target.getName() << " for " << damage << " damage!\n";
+            GAME_LOG(Attack, name, target.getName(), { damage }, flags, combatKind());
         } else {
-            std::cout << name << " attacks " << target.getName() << ", but it has no effect!\n";
+            GAME_LOG(Attack, name, target.getName(), { 0 }, gamelog::kNoEffect, combatKind());
         }
     }
 
-    // Переопределение метода heal
-    void heal(int amount) override {
-        Entity::heal(amount); // Используем базовую реализацию
-        std::cout << name << "'s current HP: " << health << "/" << maxHealth << "\n";
-    }
+    // heal() базовый: текущее здоровье персонажа выводит formatCombat
 
     // Переопределение метода displayInfo
     void displayInfo() const override {
-        std::cout << "Character: " << name << ", HP: " << health
-                  << ", Attack: " << attackPower << ", Defense: " << defense << std::endl;
+        GAME_LOG(Status, name, {}, { health, attackPower, defense }, 0, combatKind());
+    }
+};
+
+// === Текстовый вывод событий боя ===
+// Форматтер журнала: прежние сообщения attack(), heal() и displayInfo()
+void formatCombat(const gamelog::Event& e, std::string& out) {
+    using gamelog::EventKind;
+    switch (e.kind) {
+    case EventKind::Attack:
+        if (e.flags & gamelog::kSpecial) {
+            out.append(e.target()); // Название способности
+            out += "! ";
+            out.append(e.actor());
+            out += " deals additional ";
+            gamelog::appendInt(out, e.values[0]);
+            out += " fire damage!\n";
+            return;
+        }
+        if (e.flags & gamelog::kCritical) out += "Critical hit! ";
+        if (e.flags & gamelog::kPoison) out += "Poisonous attack! ";
+        out.append(e.actor());
+        out += " attacks ";
+        out.append(e.target());
+        if (e.flags & gamelog::kNoEffect) {
+            out += ", but it has no effect!\n";
+        }
+        else {
+            out += " for ";
+            gamelog::appendInt(out, e.values[0]);
+            out += " damage!\n";
+        }
+        return;
+    case EventKind::Heal:
+        out.append(e.actor());
+        out += " healed for ";
+        gamelog::appendInt(out, e.values[0]);
+        out += " HP!\n";
+        if (e.source == KindCharacter) {
+            out.append(e.actor());
+            out += "'s current HP: ";
+            gamelog::appendInt(out, e.values[1]);
+            out += '/';
+            gamelog::appendInt(out, e.values[2]);
+            out += '\n';
+        }
+        return;
+    case EventKind::Status:
+        switch (e.source) {
+        case KindCharacter: out += "Character: "; break;
+        case KindMonster: out += "Monster: "; break;
+        case KindBoss: out += "Boss: "; break;
+        default: out += "Name: "; break;
+        }
+        out.append(e.actor());
+        out += ", HP: ";
+        gamelog::appendInt(out, e.values[0]);
+        if (e.source == KindBoss) {
+            out += ", Ability: ";
+            out.append(e.target());
+        }
+        else {
+            out += ", Attack: ";
+            gamelog::appendInt(out, e.values[1]);
+            out += ", Defense: ";
+            gamelog::appendInt(out, e.values[2]);
+        }
+        out += '\n';
+        return;
+    default:
+        gamelog::formatText(e, out);
+        return;
+    }
+}
+
+// === Пакетная обработка ударов (структура массивов) ===
+// Характеристики всех сущностей хранятся в отдельных непрерывных массивах,
+// удары обрабатываются пачками без виртуальных вызовов и вывода.
+// Правила совпадают с attack() классов Character, Monster и Boss.
+class CombatStore {
+public:
+    std::vector<int> health;
+    std::vector<int> attackPower;
+    std::vector<int> defense;
+    std::vector<int> maxHealth;
+    std::vector<int> kind;
+
+    // Копирование сущности в хранилище; возвращает её индекс
+    uint32_t add(const Entity& e) {
+        health.push_back(e.getHealth());
+        attackPower.push_back(e.getAttackPower());
+        defense.push_back(e.getDefense());
+        maxHealth.push_back(e.getMaxHealth());
+        kind.push_back(e.combatKind());
+        return static_cast<uint32_t>(health.size() - 1);
+    }
+
+    size_t size() const { return health.size(); }
+
+    // Удар i: attackers[i] атакует targets[i] с номером удара firstHit + i.
+    // Урон считается векторно, затем применяется к здоровью по порядку,
+    // чтобы повторяющиеся цели давали тот же результат, что и последовательные attack().
+    void resolveAttacks(const std::vector<uint32_t>& attackers, const std::vector<uint32_t>& targets,
+                        uint32_t seed, uint32_t firstHit) {
+        const size_t n = std::min(attackers.size(), targets.size());
+        for (size_t begin = 0; begin < n; begin += kChunk) {
+            const size_t count = std::min(kChunk, n - begin);
+
+            // Сбор характеристик участников в плотные буферы
+            for (size_t i = 0; i < count; ++i) {
+                uint32_t a = attackers[begin + i];
+                uint32_t t = targets[begin + i];
+                atk[i] = attackPower[a];
+                def[i] = defense[t];
+                kinds[i] = kind[a];
+            }
+            // Броски зависят только от номера удара — цикл без ветвлений
+            for (size_t i = 0; i < count; ++i) {
+                uint32_t hit = firstHit + static_cast<uint32_t>(begin + i);
+                mainRoll[i] = rollPercent(seed, hit, kMainRoll);
+                fireRoll[i] = rollPercent(seed, hit, kFireRoll);
+            }
+
+            computeDamage(count);
+
+            // Применение урона: min(..., maxHealth), как в setHealth()
+            for (size_t i = 0; i < count; ++i) {
+                uint32_t t = targets[begin + i];
+                int h = std::min(health[t] - damage[i], maxHealth[t]);
+                health[t] = std::min(h - fire[i], maxHealth[t]);
+            }
+        }
+    }
+
+private:
+    static constexpr size_t kChunk = 256;
+
+    alignas(16) int atk[kChunk];
+    alignas(16) int def[kChunk];
+    alignas(16) int kinds[kChunk];
+    alignas(16) int mainRoll[kChunk];
+    alignas(16) int fireRoll[kChunk];
+    alignas(16) int damage[kChunk];
+    alignas(16) int fire[kChunk];
+
+    // Урон удара: max(0, atk - def), затем крит x2 (Character), +5 яд (Monster/Boss)
+    // и отдельный огненный урон 10 (Boss)
+    void computeDamage(size_t count) {
+        size_t i = 0;
+#if defined(LB_COMBAT_SSE2)
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i characterKind = _mm_set1_epi32(KindCharacter);
+        const __m128i monsterKind = _mm_set1_epi32(KindMonster);
+        const __m128i bossKind = _mm_set1_epi32(KindBoss);
+        const __m128i critChance = _mm_set1_epi32(20);
+        const __m128i poisonChance = _mm_set1_epi32(30);
+        const __m128i fireChance = _mm_set1_epi32(25);
+        const __m128i poisonDamage = _mm_set1_epi32(5);
+        const __m128i fireDamage = _mm_set1_epi32(10);
+        for (; i + 4 <= count; i += 4) {
+            __m128i a = _mm_load_si128(reinterpret_cast<const __m128i*>(atk + i));
+            __m128i d = _mm_load_si128(reinterpret_cast<const __m128i*>(def + i));
+            __m128i k = _mm_load_si128(reinterpret_cast<const __m128i*>(kinds + i));
+            __m128i r0 = _mm_load_si128(reinterpret_cast<const __m128i*>(mainRoll + i));
+            __m128i r1 = _mm_load_si128(reinterpret_cast<const __m128i*>(fireRoll + i));
+
+            // max(0, a - d) без SSE4.1: маска положительных разностей
+            __m128i diff = _mm_sub_epi32(a, d);
+            __m128i hits = _mm_cmpgt_epi32(diff, zero);
+            __m128i base = _mm_and_si128(diff, hits);
+            __m128i isBoss = _mm_cmpeq_epi32(k, bossKind);
+            __m128i isMonster = _mm_or_si128(_mm_cmpeq_epi32(k, monsterKind), isBoss);
+            __m128i crit = _mm_and_si128(_mm_and_si128(_mm_cmpeq_epi32(k, characterKind), hits),
+                                         _mm_cmplt_epi32(r0, critChance));
+            __m128i poison = _mm_and_si128(_mm_and_si128(isMonster, hits), _mm_cmplt_epi32(r0, poisonChance));
+            __m128i burn = _mm_and_si128(isBoss, _mm_cmplt_epi32(r1, fireChance));
+
+            __m128i dmg = _mm_add_epi32(base, _mm_and_si128(base, crit));
+            dmg = _mm_add_epi32(dmg, _mm_and_si128(poisonDamage, poison));
+            _mm_store_si128(reinterpret_cast<__m128i*>(damage + i), dmg);
+            _mm_store_si128(reinterpret_cast<__m128i*>(fire + i), _mm_and_si128(fireDamage, burn));
+        }
+#endif
+        for (; i < count; ++i) {
+            int base = std::max(0, atk[i] - def[i]);
+            bool hits = base > 0;
+            bool isBoss = kinds[i] == KindBoss;
+            bool isMonster = kinds[i] == KindMonster || isBoss;
+            bool crit = kinds[i] == KindCharacter && hits && mainRoll[i] < 20;
+            bool poison = isMonster && hits && mainRoll[i] < 30;
+            damage[i] = base + (crit ? base : 0) + (poison ? 5 : 0);
+            fire[i] = (isBoss && fireRoll[i] < 25) ? 10 : 0;
+        }
     }
 };
 
+// Сверка пакетного ядра с виртуальными attack() на одном и том же наборе ударов
+bool crossCheckCombat(uint32_t seed, size_t hits) {
+    std::vector<Entity*> entities = {
+        new Character("Hero", 100, 20, 10),
+        new Character("Rogue", 80, 25, 6),
+        new Monster("Goblin", 60, 15, 5),
+        new Monster("Orc", 90, 18, 12),
+        new Boss("Dragon", 500, 30, 20, "Inferno Breath"),
+        new Entity("Dummy", 200, 8, 0),
+    };
+
+    CombatStore store;
+    for (auto* e : entities) store.add(*e);
+
+    std::vector<uint32_t> attackers, targets;
+    for (size_t i = 0; i < hits; ++i) {
+        uint32_t a = combatHash(seed, static_cast<uint32_t>(i), 7) % entities.size();
+        uint32_t t = (a + 1 + combatHash(seed, static_cast<uint32_t>(i), 8) % (entities.size() - 1)) % entities.size();
+        attackers.push_back(a);
+        targets.push_back(t);
+    }
+
+    // Виртуальный путь журналирует каждый удар — на время сверки журнал отключаем
+    gamelog::Level savedLevel = gamelog::level();
+    gamelog::setLevel(gamelog::Level::Off);
+    combatSeed = seed;
+    combatCounter = 0;
+    for (size_t i = 0; i < hits; ++i) {
+        entities[attackers[i]]->attack(*entities[targets[i]]);
+    }
+    gamelog::setLevel(savedLevel);
+
+    store.resolveAttacks(attackers, targets, seed, 0);
+
+    bool same = true;
+    for (size_t i = 0; i < entities.size(); ++i) {
+        same = same && entities[i]->getHealth() == store.health[i];
+    }
+    for (auto* e : entities) delete e;
+    return same;
+}
+
 int main() {
-    srand(static_cast<unsigned>(time(0))); // Инициализация генератора случайных чисел
+    combatSeed = static_cast<uint32_t>(time(0)); // Инициализация генератора случайных чисел
+    gamelog::setFormatter(formatCombat);
 
     // Создание объектов
     Character hero("Hero", 100, 20, 10);
@@ -160,5 +440,28 @@ int main() {
     hero.attack(dragon);
     dragon.attack(hero);
 
+    // Пакетный режим: сверка с виртуальными attack() и замер скорости
+    gamelog::flush(); // Дальше вывод идёт напрямую в std::cout
+    std::cout << "Batch kernel matches virtual attack(): "
+              << (crossCheckCombat(combatSeed, 10000) ? "yes" : "NO") << "\n";
+
+    CombatStore store;
+    const uint32_t entityCount = 100000;
+    for (uint32_t i = 0; i < entityCount; ++i) {
+        if (i % 3 == 0) store.add(Character("Hero", 100, 20, 10));
+        else if (i % 3 == 1) store.add(Monster("Goblin", 60, 15, 5));
+        else store.add(Boss("Dragon", 500, 30, 20, "Inferno Breath"));
+    }
+    std::vector<uint32_t> attackers(entityCount * 10), targets(entityCount * 10);
+    for (size_t i = 0; i < attackers.size(); ++i) {
+        attackers[i] = static_cast<uint32_t>(i % entityCount);
+        targets[i] = static_cast<uint32_t>((i * 7 + 1) % entityCount);
+    }
+    auto start = std::chrono::steady_clock::now();
+    store.resolveAttacks(attackers, targets, combatSeed, 0);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "Batch: " << attackers.size() << " hits in " << seconds * 1000 << " ms ("
+              << (seconds > 0 ? attackers.size() / seconds : 0.0) << " hits/s)\n";
+
     return 0;
-}
\ No newline at end of file
+}
\ No newline at end of file
@@ -22,7 +22,7 @@ public:
 
     void displayInfo() const {
         std::cout << "Name: " << name << ", HP: " << health
-                  << ", Attack: " << attack << ", Defense: " << defense << std::endl;
+                  << ", Attack: " << attack << ", Defense: " << defense << "\n";
     }
 };
 
@@ -47,7 +47,7 @@ public:
 
     void displayInfo() const {
         std::cout << "Name: " << name << ", HP: " << health
-                  << ", Attack: " << attack << ", Defense: " << defense << std::endl;
+                  << ", Attack: " << attack << ", Defense: " << defense << "\n";
     }
 };
 
@@ -73,7 +73,7 @@ public:
     // Метод для отображения информации об оружии
     void displayInfo() const {
         std::cout << "Weapon: " << name << ", Damage: " << damage
-                  << ", Weight: " << weight << " kg" << std::endl;
+                  << ", Weight: " << weight << " kg" << "\n";
     }
 };
 
@@ -1,28 +1,12 @@
 #include <iostream>
-#include <memory>
-#include <vector>
+#include <string>
 
-class Inventory {
-private:
-    std::vector<std::unique_ptr<std::string>> items; // Вектор умных указателей на строки
-
-public:
-    // Метод для добавления предмета
-    void addItem(const std::string& item) {
-        items.push_back(std::make_unique<std::string>(item));
-    }
-
-    // Метод для отображения инвентаря
-    void displayInventory() const {
-        std::cout << "Inventory:\n";
-        for (const auto& item : items) {
-            std::cout << "- " << *item << std::endl; // Разыменовываем указатель для получения строки
-        }
-    }
-};
+#include "Inventory.h" // Инвентарь со стопками предметов
 
 int main() {
-    Inventory inventory;
+    // Инвентарь без вывода сообщений при добавлении: имена хранятся один раз,
+    // одинаковые предметы складываются в стопку вместо отдельной строки в куче
+    Inventory<std::string> inventory(false);
 
     // Добавляем предметы в инвентарь
     inventory.addItem("Sword");
@@ -30,7 +14,7 @@ int main() {
     inventory.addItem("Bow");
 
     // Отображаем инвентарь
-    inventory.displayInventory();
+    inventory.displayItems("Inventory:");
 
     return 0;
-}
\ No newline at end of file
+}
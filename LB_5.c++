@@ -1,44 +1,8 @@
 #include <iostream>
-#include <vector>
+#include <string>
 #include <stdexcept>
 
-template <typename T>
-class Queue {
-private:
-    std::vector<T> items; // Вектор для хранения элементов очереди
-
-public:
-    // Метод для добавления элемента в очередь
-    void push(const T& item) {
-        items.push_back(item);
-    }
-
-    // Метод для удаления элемента из очереди
-    void pop() {
-        if (items.empty()) {
-            throw std::out_of_range("Queue is empty, cannot pop.");
-        }
-        items.erase(items.begin()); // Удаляем первый элемент
-    }
-
-    // Метод для получения первого элемента
-    T front() const {
-        if (items.empty()) {
-            throw std::out_of_range("Queue is empty, cannot access front.");
-        }
-        return items.front(); // Возвращаем первый элемент
-    }
-
-    // Метод для проверки, пуста ли очередь
-    bool isEmpty() const {
-        return items.empty();
-    }
-
-    // Метод для получения размера очереди
-    size_t size() const {
-        return items.size();
-    }
-};
+#include "Queue.h" // Кольцевая очередь Queue<T>
 
 int main() {
     // Пример использования очереди для строк
@@ -66,4 +30,4 @@ int main() {
     }
 
     return 0;
-}
\ No newline at end of file
+}
\ No newline at end of file
@@ -1,93 +1,51 @@
 #include <iostream>
-#include <fstream>
-#include <vector>
 #include <stdexcept>
 #include <string>
-
-// Определение базового класса Entity
-class Entity {
-public:
-    virtual ~Entity() = default;
-    virtual std::string getName() const = 0;
-    virtual int getHealth() const = 0;
-    virtual int getLevel() const = 0;
-    virtual std::string serialize() const = 0; // Метод для сериализации
-};
-
-// Определение класса Player
-class Player : public Entity {
-private:
-    std::string name;
-    int health;
-    int level;
-
-public:
-    Player(const std::string& name, int health, int level)
-        : name(name), health(health), level(level) {}
-
-    std::string getName() const override { return name; }
-    int getHealth() const override { return health; }
-    int getLevel() const override { return level; }
-
-    std::string serialize() const override {
-        return name + " " + std::to_string(health) + " " + std::to_string(level);
-    }
-};
-
-// Определение класса GameManager
-template <typename T>
-class GameManager {
-private:
-    std::vector<T> entities;
-
-public:
-    void addEntity(T entity) {
-        entities.push_back(entity);
-    }
-
-    const std::vector<T>& getEntities() const {
-        return entities;
-    }
-
-    void displayAll() const {
-        for (const auto& entity : entities) {
-            std::cout << entity->getName() << " (Health: " << entity->getHealth()
-                      << ", Level: " << entity->getLevel() << ")\n";
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "GameManager.h" // Игроки в пуле объектов, сохранение и загрузка
+#include "Timing.h"      // peakMemoryMb
+
+// Замер сохранения и загрузки: LB_7.1 --bench [записей] [save|load|all]
+void runBenchmark(size_t count, const std::string& mode) {
+    const std::string filename = "game_save_bench.txt";
+    auto measure = [](const char* label, auto&& action) {
+        auto start = std::chrono::steady_clock::now();
+        action();
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        std::cout << label << ": " << ms << " ms\n";
+    };
+
+    if (mode == "save" || mode == "all") {
+        GameManager<Player> manager;
+        manager.reserve(count);
+        const char* names[] = { "Hero", "Mage", "Warrior", "Rogue", "Paladin" };
+        for (size_t i = 0; i < count; ++i) {
+            manager.addEntity(names[i % 5], static_cast<int>(50 + i % 100), static_cast<int>(1 + i % 60));
         }
+        measure("Save", [&] { saveToFile(manager, filename); });
     }
-};
-
-// Метод для сохранения данных в файл
-void saveToFile(const GameManager<Entity*>& manager, const std::string& filename) {
-    std::ofstream file(filename);
-    if (!file) {
-        throw std::runtime_error("Failed to open file for writing.");
-    }
-
-    for (const auto& entity : manager.getEntities()) {
-        file << entity->serialize() << "\n"; // Сохраняем данные о каждом персонаже
+    if (mode == "load" || mode == "all") {
+        GameManager<Player> loaded;
+        measure("Load", [&] { loadFromFile(loaded, filename); });
+        std::cout << "Loaded entities: " << loaded.size() << "\n";
     }
+    std::cout << "Peak RSS: " << peakMemoryMb() << " MB\n";
 }
 
-// Метод для загрузки данных из файла
-void loadFromFile(GameManager<Entity*>& manager, const std::string& filename) {
-    std::ifstream file(filename);
-    if (!file) {
-        throw std::runtime_error("Failed to open file for reading.");
-    }
-
-    std::string name;
-    int health, level;
-    while (file >> name >> health >> level) {
-        manager.addEntity(new Player(name, health, level)); // Загружаем данные о персонаже
+int main(int argc, char* argv[]) {
+    if (argc > 1 && std::strcmp(argv[1], "--bench") == 0) {
+        runBenchmark(argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 10000000, argc > 3 ? argv[3] : "all");
+        return 0;
     }
-}
 
-int main() {
-    GameManager<Entity*> manager;
-    manager.addEntity(new Player("Hero", 100, 1));
-    manager.addEntity(new Player("Mage", 80, 2));
-    manager.addEntity(new Player("Warrior", 120, 3));
+    GameManager<Player> manager;
+    manager.addEntity("Hero", 100, 1);
+    manager.addEntity("Mage", 80, 2);
+    manager.addEntity("Warrior", 120, 3);
 
     // Сохранение данных в файл
     try {
@@ -98,7 +56,7 @@ int main() {
     }
 
     // Загрузка данных из файла
-    GameManager<Entity*> loadedManager;
+    GameManager<Player> loadedManager;
     try {
         loadFromFile(loadedManager, "game_save.txt");
         std::cout << "Game data loaded from game_save.txt" << std::endl;
@@ -107,13 +65,7 @@ int main() {
         std::cerr << "Error: " << e.what() << std::endl;
     }
 
-    // Освобождение памяти
-    for (auto entity : manager.getEntities()) {
-        delete entity;
-    }
-    for (auto entity : loadedManager.getEntities()) {
-        delete entity;
-    }
+    // Память освобождается пулами менеджеров целиком
 
     return 0;
-}
\ No newline at end of file
+}
@@ -1,9 +1,24 @@
 #include <thread>
 #include <mutex>
+#include <condition_variable>
 #include <vector>
 #include <chrono>
 #include <iostream>
 #include <atomic>
+#include <string>
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+
+#include "Queue.h"
+#include "BattleSim.h" // Безголовая симуляция боёв
+#include "Log.h"
+
+// Вид сущности в событиях журнала
+const uint8_t kSourceMonster = 0;
+const uint8_t kSourceCharacter = 1;
 
 class Monster {
 public:
@@ -15,8 +30,7 @@ public:
     Monster(std::string n, int h, int a, int d) : name(n), health(h), attack(a), defense(d) {}
 
     void displayInfo() {
-        std::cout << "Monster: " << name << ", Health: " << health 
-                  << ", Attack: " << attack << ", Defense: " << defense << std::endl;
+        GAME_LOG(Status, name, {}, { health, attack, defense }, 0, kSourceMonster);
     }
 };
 
@@ -30,71 +44,135 @@ public:
     Character(std::string n, int h, int a, int d) : name(n), health(h), attack(a), defense(d) {}
 
     void displayInfo() {
-        std::cout << "Character: " << name << ", Health: " << health 
-                  << ", Attack: " << attack << ", Defense: " << defense << std::endl;
+        GAME_LOG(Status, name, {}, { health, attack, defense }, 0, kSourceCharacter);
     }
 };
 
-std::vector<Monster> monsters;
-std::mutex monstersMutex;
+MpmcQueue<Monster> spawnQueue(64);  // Очередь сгенерированных монстров
 std::atomic<bool> heroAlive(true); // Флаг, указывающий, жив ли герой
+std::mutex generatorMutex;          // Только для пробуждения генератора при остановке
+std::condition_variable generatorCv;
 
 void generateMonsters() {
+    std::unique_lock<std::mutex> lock(generatorMutex);
+    int unspawned = 0; // Монстры, не поместившиеся в заполненную очередь
     while (heroAlive) { // Генерируем монстров, пока герой жив
-        std::this_thread::sleep_for(std::chrono::seconds(3)); // Новый монстр каждые 3 секунды
-        std::lock_guard<std::mutex> lock(monstersMutex);
-        monsters.push_back(Monster("Goblin", 50, 40, 5));
-        std::cout << "New monster generated!\n";
+        // Новый монстр каждые 3 секунды; ожидание прерывается при гибели героя
+        if (generatorCv.wait_for(lock, std::chrono::seconds(3), [] { return !heroAlive; })) break;
+        ++unspawned;
+        // Если очередь заполнена, монстр не теряется, а ждёт следующей попытки
+        while (unspawned > 0 && spawnQueue.try_push(Monster("Goblin", 50, 40, 5))) {
+            --unspawned;
+            GAME_LOG(Spawn, "Goblin", {}, {});
+        }
+    }
+}
+
+// Форматтер журнала: прежние сообщения боя
+void formatBattle(const gamelog::Event& e, std::string& out) {
+    switch (e.kind) {
+    case gamelog::EventKind::Attack:
+        out.append(e.actor());
+        out += " attacks ";
+        out.append(e.target());
+        out += "!\n";
+        out.append(e.target());
+        out += " has ";
+        gamelog::appendInt(out, e.values[1]);
+        out += " health left.\n";
+        break;
+    case gamelog::EventKind::Spawn:
+        out += "New monster generated!\n";
+        break;
+    case gamelog::EventKind::Status:
+        out += e.source == kSourceCharacter ? "Character: " : "Monster: ";
+        out.append(e.actor());
+        out += ", Health: ";
+        gamelog::appendInt(out, e.values[0]);
+        out += ", Attack: ";
+        gamelog::appendInt(out, e.values[1]);
+        out += ", Defense: ";
+        gamelog::appendInt(out, e.values[2]);
+        out += '\n';
+        break;
+    default:
+        gamelog::formatText(e, out);
+        break;
     }
 }
 
 void battle(Character& hero, Monster& monster) {
     while (hero.health > 0 && monster.health > 0) {
         std::this_thread::sleep_for(std::chrono::seconds(1)); // Задержка 1 секунда перед атакой
-        
+
         // Логика боя: герой атакует монстра
-        monster.health -= std::max(0, hero.attack - monster.defense);
-        std::cout << hero.name << " attacks " << monster.name << "!\n";
-        std::cout << monster.name << " has " << monster.health << " health left.\n";
+        int damage = std::max(0, hero.attack - monster.defense);
+        monster.health -= damage;
+        GAME_LOG(Attack, hero.name, monster.name, { damage, monster.health }, 0, kSourceCharacter);
 
         // Проверяем, жив ли монстр после атаки
         if (monster.health <= 0) {
-            std::cout << monster.name << " has been defeated!\n";
+            GAME_LOG(Defeat, monster.name, {}, {}, 0, kSourceMonster);
             break; // Выходим из цикла, если монстр мёртв
         }
 
         // Монстр атакует героя
-        hero.health -= std::max(0, monster.attack - hero.defense);
-        std::cout << monster.name << " attacks " << hero.name << "!\n";
-        std::cout << hero.name << " has " << hero.health << " health left.\n";
+        damage = std::max(0, monster.attack - hero.defense);
+        hero.health -= damage;
+        GAME_LOG(Attack, monster.name, hero.name, { damage, hero.health }, 0, kSourceMonster);
     }
 
     if (hero.health <= 0) {
-        std::cout << hero.name << " has been defeated!\n";
+        GAME_LOG(Defeat, hero.name, {}, {}, 0, kSourceCharacter);
         heroAlive = false; // Устанавливаем флаг, что герой мёртв
     }
 }
 
-int main() {
+int main(int argc, char* argv[]) {
+    // Режим симуляции: LB_7.2 --simulate <боёв> [потоков] [seed]
+    if (argc > 1 && std::strcmp(argv[1], "--simulate") == 0) {
+        uint64_t battles = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 1000000;
+        size_t threads = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : std::thread::hardware_concurrency();
+        uint64_t seed = argc > 4 ? std::strtoull(argv[4], nullptr, 10) : 42;
+        SimulationResult result = runSimulation(battles, threads, seed);
+        std::cout << "Threads: " << result.threads << "\n"
+                  << "Battles: " << result.battles << "\n"
+                  << "Hero wins: " << result.heroWins << "\n"
+                  << "Total rounds: " << result.rounds << "\n"
+                  << "Time: " << result.seconds << " s\n"
+                  << "Battles per second: " << result.battlesPerSecond() << "\n";
+        return 0;
+    }
+
+    gamelog::setFormatter(formatBattle);
     std::thread monsterGenerator(generateMonsters);
-    monsterGenerator.detach(); // Отсоединяем поток
 
     Character hero("Hero", 100, 50, 10);
+    Monster monster("", 0, 0, 0);
+    std::deque<Monster> monsters; // Ожидающие боя монстры; принадлежат только основному потоку
 
     while (heroAlive) {
         std::this_thread::sleep_for(std::chrono::seconds(1));
 
-        std::lock_guard<std::mutex> lock(monstersMutex);
+        while (spawnQueue.try_pop(monster)) {
+            monsters.push_back(std::move(monster));
+        }
         if (!monsters.empty()) {
-            Monster& monster = monsters.front(); // Берем первого сгенерированного монстра
-            battle(hero, monster); // Начинаем бой с монстром
-            monsters.erase(monsters.begin()); // Удаляем монстра после боя
+            battle(hero, monsters.front()); // Начинаем бой с первым сгенерированным монстром
+            monsters.pop_front(); // Удаляем монстра после боя
         }
-        for (auto& monster : monsters) {
-            monster.displayInfo();
+        for (auto& waiting : monsters) {
+            waiting.displayInfo();
         }
     }
 
+    {
+        std::lock_guard<std::mutex> lock(generatorMutex);
+    }
+    generatorCv.notify_all();
+    monsterGenerator.join(); // Дожидаемся остановки генератора вместо detach()
+
+    gamelog::flush();
     std::cout << "No more monsters will be generated.\n";
     return 0;
-}
\ No newline at end of file
+}
@@ -1,249 +1,76 @@
 #include <iostream>
-#include <fstream>
 #include <vector>
 #include <string>
 #include <memory>
-#include <sstream>
 #include <stdexcept>
 #include <ctime>
 #include <cstdlib>
 #include <locale>
 
-// ===== Инвентарь =====
-template<typename T>
-class Inventory {
-private:
-    std::vector<T> items;
-
-public:
-    void addItem(const T& item) {
-        items.push_back(item);
-        std::cout << "Предмет добавлен: " << item << "\n";
-    }
-
-    bool removeItem(const T& item) {
-        for (auto it = items.begin(); it != items.end(); ++it) {
-            if (*it == item) {
-                items.erase(it);
-                std::cout << "Предмет удалён: " << item << "\n";
-                return true;
-            }
-        }
-        std::cout << "Предмет не найден в инвентаре: " << item << "\n";
-        return false;
-    }
-
-    const std::vector<T>& getItems() const {
-        return items;
-    }
+#include "Character.h" // Персонаж, монстры и журнал сохранений
 
-    void displayItems() const {
-        std::cout << "Инвентарь:\n";
-        for (const auto& item : items) {
-            std::cout << "- " << item << "\n";
-        }
-    }
-
-    void clear() {
-        items.clear();
-    }
-};
-
-// ===== Класс Персонаж =====
-class Character {
+// ===== Игровая логика =====
+class Game {
 private:
-    std::string name;
-    int health;
-    int attack;
-    int defense;
-    int level;
-    int experience;
-
-public:
-    Inventory<std::string> inventory;
-
-    Character(const std::string& n = "Герой", int h = 100, int a = 10, int d = 5)
-        : name(n), health(h), attack(a), defense(d), level(1), experience(0) {}
-
-    void attackEnemy(class Monster& enemy);
-
-    void heal(int amount) {
-        health += amount;
-        if (health > 100) health = 100;
-        if (amount > 0) {
-            std::cout << name << " восстанавливает " << amount << " HP!\n";
-        }
-        else {
-            std::cout << name << " получает урон: " << -amount << " HP!\n";
-        }
-    }
-
-    void gainExperience(int exp);
-
-    void displayInfo() const {
-        std::cout << "Имя: " << name << "\nHP: " << health
-            << "\nАтака: " << attack << "\nЗащита: " << defense
-            << "\nУровень: " << level << "\nОпыт: " << experience << "\n";
-        inventory.displayItems();
-    }
-
-    bool isAlive() const { return health > 0; }
-    int getHealth() const { return health; }
-    const std::string& getName() const { return name; }
-    int getDefense() const { return defense; }
-
-    void saveToFile(const std::string& filename);
-    void loadFromFile(const std::string& filename);
-};
+    Character player;
+    std::vector<std::unique_ptr<Monster>> monsters;
+    SaveJournal journal{ "save.txt", "save.journal" };
+    bool journalAvailable = false;
 
-// ===== Базовый класс Монстр =====
-class Monster {
-protected:
-    std::string name;
-    int health;
-    int attackPower;
-    int defense;
+    bool saveGame(bool waitForDisk);
+    void closeJournal();
 
 public:
-    virtual ~Monster() = default;
+    void start();
+    void battle(Monster& monster);
+};
 
-    virtual void attack(Character& player) {
-        int baseDamage = attackPower - player.getDefense();
-        if (baseDamage > 0) {
-            player.heal(-baseDamage);
-            std::cout << name << " атакует " << player.getName() << " и наносит " << baseDamage << " урона!\n";
+// Сохранение метки в журнале; если журнал недоступен — полная запись save.txt.
+// waitForDisk: дождаться записи журнала (в конце игры), иначе запись идёт в фоне,
+// а её ошибка проявится при следующем сохранении или при закрытии журнала.
+bool Game::saveGame(bool waitForDisk) {
+    if (journalAvailable) {
+        try {
+            journal.commit();
+            if (waitForDisk) journal.close();
+            return true;
         }
-        else {
-            // Добавляем случайный урон от 1 до 3, чтобы гарантировать минимум 1 урон
-            int randomDamage = rand() % 3 + 1;
-            player.heal(-randomDamage);
-            std::cout << name << " атакует " << player.getName() << " и наносит " << randomDamage << " урона!\n";
+        catch (const std::exception & e) {
+            std::cout << "Ошибка журнала сохранений: " << e.what() << "\n";
+            journalAvailable = false;
         }
     }
-
-    virtual void takeDamage(int damage) {
-        health -= damage;
-        if (health < 0) health = 0;
-    }
-
-    virtual bool isAlive() const { return health > 0; }
-    virtual const std::string& getName() const { return name; }
-    virtual int getDefense() const { return defense; }
-
-    virtual void displayInfo() const {
-        std::cout << "Монстр: " << name << "\nHP: " << health
-            << "\nАтака: " << attackPower << "\nЗащита: " << defense << "\n";
-    }
-};
-
-// ===== Конкретные монстры =====
-class Goblin : public Monster {
-public:
-    Goblin() {
-        name = "Гоблин";
-        health = 30;
-        attackPower = 12; 
-        defense = 3;
-    }
-};
-
-class Skeleton : public Monster {
-public:
-    Skeleton() {
-        name = "Скелет";
-        health = 40;
-        attackPower = 15;
-        defense = 5;
-    }
-};
-
-class Dragon : public Monster {
-public:
-    Dragon() {
-        name = "Дракон";
-        health = 100;
-        attackPower = 20;
-        defense = 10;
-    }
-};
-
-// ===== Реализация методов класса Character =====
-void Character::attackEnemy(Monster& enemy) {
-    int damage = attack - enemy.getDefense();
-    if (damage > 0) {
-        enemy.takeDamage(damage);
-        std::cout << name << " атакует " << enemy.getName() << " и наносит " << damage << " урона!\n";
+    try {
+        journal.saveDirect(player);
+        return true;
     }
-    else {
-        std::cout << name << " атакует " << enemy.getName() << ", но без эффекта.\n";
+    catch (const std::exception & e) {
+        std::cout << "Не удалось сохранить игру: " << e.what() << "\n";
+        return false;
     }
 }
 
-void Character::saveToFile(const std::string& filename) {
-    std::ofstream file(filename);
-    if (!file.is_open()) throw std::runtime_error("Не удалось открыть файл для сохранения.");
-
-    file << name << '\n' << health << '\n' << attack << '\n'
-        << defense << '\n' << level << '\n' << experience << '\n';
-
-    for (const auto& item : inventory.getItems()) {
-        file << item << '\n';
-    }
-    file << "END_ITEMS\n";
-
-    file.close();
-    std::cout << "Прогресс успешно сохранён.\n";
-}
-
-void Character::loadFromFile(const std::string& filename) {
-    std::ifstream file(filename);
-    if (!file.is_open()) throw std::runtime_error("Не удалось открыть файл для загрузки.");
-
-    std::getline(file, name);
-    file >> health >> attack >> defense >> level >> experience;
-    file.ignore();
-
-    std::string line;
-    inventory.clear();
-    while (std::getline(file, line)) {
-        if (line == "END_ITEMS") break;
-        inventory.addItem(line);
+void Game::closeJournal() {
+    try {
+        journal.close();
     }
-
-    file.close();
-    std::cout << "Прогресс успешно загружен.\n";
-}
-
-void Character::gainExperience(int exp) {
-    experience += exp;
-    while (experience >= level * 100) {
-        experience -= level * 100;
-        level++;
-        attack += 2;
-        defense += 1;
-        std::cout << name << " повысил уровень! Теперь уровень: " << level << "\n";
+    catch (const std::exception & e) {
+        std::cout << "Ошибка журнала сохранений, последние сохранения могли не записаться: " << e.what() << "\n";
     }
 }
 
-// ===== Игровая логика =====
-class Game {
-private:
-    Character player;
-    std::vector<std::unique_ptr<Monster>> monsters;
-
-public:
-    void start();
-    void battle(Monster& monster);
-};
-
 void Game::start() {
     srand(static_cast<unsigned int>(time(0)));
 
     try {
-        player.loadFromFile("save.txt");
+        if (!journal.restore(player)) {
+            std::cout << "Файл сохранения не найден. Начинаем новую игру.\n";
+        }
+        journal.start(player);
+        journalAvailable = true;
     }
-    catch (...) {
-        std::cout << "Файл сохранения не найден. Начинаем новую игру.\n";
+    catch (const std::exception & e) {
+        std::cout << "Журнал сохранений недоступен, игра будет сохраняться целиком: " << e.what() << "\n";
     }
 
     player.displayInfo();
@@ -257,18 +84,21 @@ void Game::start() {
         if (!player.isAlive()) break;
     }
 
+    gamelog::flush();
     if (player.isAlive()) {
         std::cout << "Вы победили всех врагов! Победа!\n";
-        player.saveToFile("save.txt");
+        if (saveGame(true)) std::cout << "Прогресс успешно сохранён.\n";
     }
+    closeJournal();
 }
 
 void Game::battle(Monster& monster) {
-    std::cout << "На вас напал " << monster.getName() << "!\n";
+    GAME_LOG(Spawn, monster.getName(), {}, {}, 0, kSourceMonster);
     while (player.isAlive() && monster.isAlive()) {
         // Меню действий
         int choice;
         do {
+            gamelog::flush(); // Меню и ввод идут напрямую через std::cout/std::cin
             std::cout << "\nВыберите действие:\n";
             std::cout << "1. Атаковать\n";
             std::cout << "2. Лечиться\n";
@@ -282,7 +112,7 @@ void Game::battle(Monster& monster) {
                 player.attackEnemy(monster);
                 break;
             case 2:
-                if (player.inventory.removeItem("Зелье здоровья")) {
+                if (player.useItem("Зелье здоровья")) {
                     player.heal(25);
                 }
                 else {
@@ -290,11 +120,12 @@ void Game::battle(Monster& monster) {
                 }
                 break;
             case 3:
-                player.saveToFile("save.txt");
-                std::cout << "Игра сохранена.\n";
+                // Изменения уже в журнале — достаточно поставить метку сохранения
+                if (saveGame(false)) std::cout << "Игра сохранена.\n";
                 break;
             case 0:
                 std::cout << "Выход из игры...\n";
+                closeJournal();
                 exit(0);
                 break;
             default:
@@ -310,18 +141,19 @@ void Game::battle(Monster& monster) {
     }
 
     if (player.isAlive()) {
-        std::cout << "Вы победили " << monster.getName() << "!\n";
+        GAME_LOG(Defeat, monster.getName(), {}, {}, 0, kSourceMonster);
         player.gainExperience(50);
-        player.inventory.addItem("Зелье здоровья");
+        player.pickUpItem("Зелье здоровья");
     }
     else {
-        std::cout << "Вы были побеждены...\n";
+        GAME_LOG(Defeat, player.getName(), {}, {}, 0, kSourceCharacter);
     }
 }
 
 // ===== Точка входа =====
 int main() {
     setlocale(LC_ALL, "");
+    gamelog::setFormatter(formatGame);
 
     try {
         Game game;
@@ -0,0 +1,445 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <initializer_list>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "Queue.h"
+
+// === Асинхронный журнал игровых событий ===
+// Вызывающий поток только кладёт структурированное событие в своё кольцо,
+// а фоновый поток пачками превращает события в текст и пишет их в поток вывода.
+//
+// Уровень задаётся во время работы (setLevel или переменная окружения
+// GAMELOG_LEVEL=trace|info|off). Если определить GAMELOG_DISABLED,
+// макрос GAME_LOG не оставляет в программе никакого кода.
+//
+// Вывод в std::cout из других мест программы не упорядочен с журналом:
+// перед таким выводом (меню, ввод, итоги) нужно вызвать gamelog::flush().
+namespace gamelog {
+
+enum class EventKind : uint8_t { Attack, Heal, Damage, LevelUp, Spawn, Defeat, Status };
+
+enum class Level : uint8_t { Trace = 0, Info = 1, Off = 2 };
+
+// Удары, лечение, урон и вывод характеристик — подробный уровень,
+// появление, поражение и повышение уровня — основной
+inline Level levelOf(EventKind kind) {
+    switch (kind) {
+    case EventKind::LevelUp:
+    case EventKind::Spawn:
+    case EventKind::Defeat:
+        return Level::Info;
+    default:
+        return Level::Trace;
+    }
+}
+
+// Флаги события
+const uint8_t kNoEffect = 1; // Удар без урона
+const uint8_t kCritical = 2; // Критический удар
+const uint8_t kPoison = 4;   // Ядовитый удар
+const uint8_t kSpecial = 8;  // Особая способность (её название в target)
+
+// Событие фиксированного размера: имена копируются, чтобы событие не ссылалось
+// на объекты, которые могут исчезнуть до вывода. Имя длиннее kNameSize байт
+// (32 символа кириллицей) выводится обрезанным по границе символа.
+struct Event {
+    static constexpr size_t kNameSize = 64;
+    static constexpr size_t kValueCount = 5;
+
+    EventKind kind = EventKind::Status;
+    uint8_t flags = 0;
+    uint8_t source = 0;        // Вид сущности; значение определяет программа
+    uint8_t actorLength = 0;
+    uint8_t targetLength = 0;
+    char actorName[kNameSize];
+    char targetName[kNameSize];
+    int32_t values[kValueCount] = {};
+
+    std::string_view actor() const { return std::string_view(actorName, actorLength); }
+    std::string_view target() const { return std::string_view(targetName, targetLength); }
+
+    // Копирование имени; длинное обрезается по границе символа UTF-8
+    static uint8_t copyName(char* dest, std::string_view name) {
+        size_t length = name.size();
+        if (length > kNameSize) {
+            length = kNameSize;
+            while (length > 0 && (static_cast<unsigned char>(name[length]) & 0xC0) == 0x80) --length;
+        }
+        if (length > 0) std::memcpy(dest, name.data(), length);
+        return static_cast<uint8_t>(length);
+    }
+};
+
+// Форматтер дописывает текст события (с переводом строки) в буфер пачки
+using Formatter = void (*)(const Event& event, std::string& out);
+
+inline void appendInt(std::string& out, int value) {
+    char digits[16];
+    auto result = std::to_chars(digits, digits + sizeof(digits), value);
+    out.append(digits, result.ptr);
+}
+
+// Текстовый вывод в виде прежних сообщений LB_1.1
+inline void formatText(const Event& e, std::string& out) {
+    if (e.kind == EventKind::Status) out += "Name: ";
+    out.append(e.actor());
+    switch (e.kind) {
+    case EventKind::Attack:
+        out += " attacks ";
+        out.append(e.target());
+        if (e.flags & kNoEffect) {
+            out += ", but it has no effect!\n";
+        }
+        else {
+            out += " for ";
+            appendInt(out, e.values[0]);
+            out += " damage!\n";
+        }
+        break;
+    case EventKind::Heal:
+        out += " heals for ";
+        appendInt(out, e.values[0]);
+        out += " HP. Current HP: ";
+        appendInt(out, e.values[1]);
+        out += '\n';
+        break;
+    case EventKind::Damage:
+        out += " takes ";
+        appendInt(out, e.values[0]);
+        out += " damage. Current HP: ";
+        appendInt(out, e.values[1]);
+        out += '\n';
+        break;
+    case EventKind::LevelUp:
+        out += " reaches level ";
+        appendInt(out, e.values[0]);
+        out += "!\n";
+        break;
+    case EventKind::Spawn:
+        out += " appears!\n";
+        break;
+    case EventKind::Defeat:
+        out += " has been defeated!\n";
+        break;
+    case EventKind::Status:
+        out += ", HP: ";
+        appendInt(out, e.values[0]);
+        out += ", Attack: ";
+        appendInt(out, e.values[1]);
+        out += ", Defense: ";
+        appendInt(out, e.values[2]);
+        out += '\n';
+        break;
+    }
+}
+
+inline const char* kindName(EventKind kind) {
+    switch (kind) {
+    case EventKind::Attack: return "attack";
+    case EventKind::Heal: return "heal";
+    case EventKind::Damage: return "damage";
+    case EventKind::LevelUp: return "level_up";
+    case EventKind::Spawn: return "spawn";
+    case EventKind::Defeat: return "defeat";
+    case EventKind::Status: return "status";
+    }
+    return "unknown";
+}
+
+inline void appendJsonString(std::string& out, std::string_view text) {
+    out += '"';
+    for (char c : text) {
+        if (c == '"' || c == '\\') out += '\\';
+        if (static_cast<unsigned char>(c) < 0x20) continue; // Управляющие символы в именах не нужны
+        out += c;
+    }
+    out += '"';
+}
+
+// Машиночитаемый вывод: одна строка JSON на событие
+inline void formatJson(const Event& e, std::string& out) {
+    out += "{\"event\":\"";
+    out += kindName(e.kind);
+    out += "\",\"actor\":";
+    appendJsonString(out, e.actor());
+    if (e.targetLength > 0) {
+        out += ",\"target\":";
+        appendJsonString(out, e.target());
+    }
+    out += ",\"source\":";
+    appendInt(out, e.source);
+    out += ",\"flags\":";
+    appendInt(out, e.flags);
+    out += ",\"values\":[";
+    for (size_t i = 0; i < Event::kValueCount; ++i) {
+        if (i > 0) out += ',';
+        appendInt(out, e.values[i]);
+    }
+    out += "]}\n";
+}
+
+#ifndef GAMELOG_DISABLED
+
+namespace detail {
+
+inline Level levelFromEnvironment() {
+    const char* value = std::getenv("GAMELOG_LEVEL");
+    if (!value) return Level::Trace;
+    if (std::strcmp(value, "info") == 0) return Level::Info;
+    if (std::strcmp(value, "off") == 0) return Level::Off;
+    return Level::Trace;
+}
+
+inline std::atomic<uint8_t>& currentLevel() {
+    static std::atomic<uint8_t> level(static_cast<uint8_t>(levelFromEnvironment()));
+    return level;
+}
+
+// Кольцо событий одного потока: пишет поток-владелец, читает фоновый поток
+struct Ring {
+    static constexpr size_t kCapacity = 4096;
+
+    SpscQueue<Event> events{ kCapacity };
+    std::atomic<bool> closed{ false }; // Поток-владелец завершился
+};
+
+class Logger {
+private:
+    static constexpr auto kFlushInterval = std::chrono::milliseconds(20);
+
+    std::mutex mutex;
+    std::condition_variable wake;     // Будит фоновый поток
+    std::condition_variable flushed;  // Сообщает о выполненном flush()
+    std::vector<std::shared_ptr<Ring>> rings;
+    Formatter formatter = formatText;
+    std::ostream* output = &std::cout;
+    uint64_t flushRequests = 0;
+    uint64_t flushesDone = 0;
+    bool drainRequested = false;
+    bool stopping = false;
+    std::thread writer;
+
+    // Разбор всех колец в один буфер; false, если событий не было
+    bool drain(const std::vector<std::shared_ptr<Ring>>& snapshot, Formatter format, std::string& batch) {
+        Event event;
+        bool any = false;
+        for (const auto& ring : snapshot) {
+            // Не больше ёмкости кольца за проход, чтобы быстрый поток не задержал вывод остальных
+            for (size_t n = 0; n < Ring::kCapacity && ring->events.try_pop(event); ++n) {
+                format(event, batch);
+                any = true;
+            }
+        }
+        return any;
+    }
+
+    void writerLoop() {
+        std::vector<std::shared_ptr<Ring>> snapshot;
+        std::string batch;
+        bool busy = false; // Прошлый проход что-то вывел — события ещё могут идти потоком
+        for (;;) {
+            uint64_t request;
+            bool stop;
+            Formatter format;
+            std::ostream* out;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                if (!busy) {
+                    wake.wait_for(lock, kFlushInterval, [this] {
+                        return stopping || drainRequested || flushRequests > flushesDone;
+                    });
+                }
+                drainRequested = false;
+                request = flushRequests;
+                stop = stopping;
+                format = formatter;
+                out = output;
+                snapshot = rings;
+            }
+
+            batch.clear();
+            busy = drain(snapshot, format, batch);
+            if (busy) {
+                out->write(batch.data(), static_cast<std::streamsize>(batch.size()));
+                out->flush();
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                // Кольца завершившихся потоков больше не пополнятся
+                rings.erase(std::remove_if(rings.begin(), rings.end(), [](const std::shared_ptr<Ring>& ring) {
+                    return ring->closed.load(std::memory_order_acquire) && ring->events.isEmpty();
+                }), rings.end());
+                flushesDone = request;
+            }
+            flushed.notify_all();
+            if (stop) return;
+        }
+    }
+
+public:
+    Logger() : writer(&Logger::writerLoop, this) {}
+
+    Logger(const Logger&) = delete;
+    Logger& operator=(const Logger&) = delete;
+
+    // При завершении программы выводим всё накопленное
+    ~Logger() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_one();
+        writer.join();
+    }
+
+    static Logger& instance() {
+        static Logger logger;
+        return logger;
+    }
+
+    std::shared_ptr<Ring> registerRing() {
+        auto ring = std::make_shared<Ring>();
+        std::lock_guard<std::mutex> lock(mutex);
+        rings.push_back(ring);
+        return ring;
+    }
+
+    void setFormatter(Formatter f) {
+        std::lock_guard<std::mutex> lock(mutex);
+        formatter = f ? f : formatText;
+    }
+
+    void setOutput(std::ostream& out) {
+        std::lock_guard<std::mutex> lock(mutex);
+        output = &out;
+    }
+
+    // Будим фоновый поток без ожидания (кольцо заполняется)
+    void requestDrain() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            drainRequested = true;
+        }
+        wake.notify_one();
+    }
+
+    // Ожидание вывода всех событий, отправленных до вызова
+    void flush() {
+        std::unique_lock<std::mutex> lock(mutex);
+        if (stopping) return;
+        uint64_t request = ++flushRequests;
+        wake.notify_one();
+        flushed.wait(lock, [&] { return flushesDone >= request; });
+    }
+};
+
+// Кольцо текущего потока; создаётся при первом событии потока
+class LocalRing {
+private:
+    std::shared_ptr<Ring> ring;
+
+public:
+    LocalRing() : ring(Logger::instance().registerRing()) {}
+
+    ~LocalRing() {
+        ring->closed.store(true, std::memory_order_release);
+    }
+
+    void push(const Event& event) {
+        while (!ring->events.try_push(event)) {
+            // Кольцо заполнено: фоновый поток не успевает — ждём его
+            Logger::instance().requestDrain();
+            std::this_thread::yield();
+        }
+        if (ring->events.size() == Ring::kCapacity / 2) Logger::instance().requestDrain();
+    }
+};
+
+} // namespace detail
+
+inline Level level() {
+    return static_cast<Level>(detail::currentLevel().load(std::memory_order_relaxed));
+}
+
+inline void setLevel(Level l) {
+    detail::currentLevel().store(static_cast<uint8_t>(l), std::memory_order_relaxed);
+}
+
+inline bool enabled(EventKind kind) {
+    return levelOf(kind) >= level(); // Off выше любого уровня события
+}
+
+inline void setFormatter(Formatter f) {
+    detail::Logger::instance().setFormatter(f);
+}
+
+inline void setOutput(std::ostream& out) {
+    detail::Logger::instance().setOutput(out);
+}
+
+inline void flush() {
+    detail::Logger::instance().flush();
+}
+
+// Отправка события в кольцо текущего потока
+inline void log(EventKind kind, std::string_view actor, std::string_view target,
+                std::initializer_list<int> values, uint8_t flags = 0, uint8_t source = 0) {
+    Event event;
+    event.kind = kind;
+    event.flags = flags;
+    event.source = source;
+    event.actorLength = Event::copyName(event.actorName, actor);
+    event.targetLength = Event::copyName(event.targetName, target);
+    std::copy_n(values.begin(), std::min(values.size(), Event::kValueCount), event.values);
+
+    thread_local detail::LocalRing ring;
+    ring.push(event);
+}
+
+#else // GAMELOG_DISABLED
+
+inline Level level() { return Level::Off; }
+inline void setLevel(Level) {}
+inline bool enabled(EventKind) { return false; }
+inline void setFormatter(Formatter) {}
+inline void setOutput(std::ostream&) {}
+inline void flush() {}
+inline void log(EventKind, std::string_view, std::string_view,
+                std::initializer_list<int>, uint8_t = 0, uint8_t = 0) {}
+
+#endif
+
+} // namespace gamelog
+
+// GAME_LOG(Attack, имя, цель, {значения}, [флаги], [вид сущности])
+// Аргументы не вычисляются, если уровень события отключён.
+// С GAMELOG_DISABLED вызов стоит под if (false): код не остаётся, но переменные,
+// нужные только журналу, не вызывают предупреждений о неиспользовании.
+#ifdef GAMELOG_DISABLED
+#define GAME_LOG(kind, ...)                                                      \
+    do {                                                                         \
+        if (false) ::gamelog::log(::gamelog::EventKind::kind, __VA_ARGS__);      \
+    } while (0)
+#else
+#define GAME_LOG(kind, ...)                                                      \
+    do {                                                                         \
+        if (::gamelog::enabled(::gamelog::EventKind::kind))                      \
+            ::gamelog::log(::gamelog::EventKind::kind, __VA_ARGS__);             \
+    } while (0)
+#endif
@@ -0,0 +1,347 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+// Округление ёмкости вверх до степени двойки (индексы считаются через маску)
+inline size_t roundUpToPowerOfTwo(size_t n) {
+    size_t result = 1;
+    while (result < n) {
+        result <<= 1;
+    }
+    return result;
+}
+
+// === Растущая кольцевая очередь ===
+// push/pop за O(1), элементы не сдвигаются при удалении.
+template <typename T>
+class Queue {
+private:
+    T* buffer = nullptr;   // Сырой буфер под элементы
+    size_t capacity = 0;   // Ёмкость буфера (степень двойки или 0)
+    size_t head = 0;       // Индекс первого элемента
+    size_t count = 0;      // Количество элементов
+
+    T* slot(size_t i) const {
+        return buffer + ((head + i) & (capacity - 1));
+    }
+
+    static T* allocate(size_t n) {
+        return std::allocator<T>().allocate(n);
+    }
+
+    static void deallocate(T* p, size_t n) {
+        if (p) std::allocator<T>().deallocate(p, n);
+    }
+
+    // Перенос элементов в новый буфер вдвое большего размера.
+    // Новый элемент создаётся в новом буфере до переноса старых: аргументы
+    // могут ссылаться на элемент этой же очереди (q.push(q.front())).
+    template <typename... Args>
+    T* growAndEmplace(Args&&... args) {
+        size_t newCapacity = capacity ? capacity * 2 : 8;
+        T* newBuffer = allocate(newCapacity);
+        T* p = newBuffer + count;
+        try {
+            ::new (static_cast<void*>(p)) T(std::forward<Args>(args)...);
+        } catch (...) {
+            deallocate(newBuffer, newCapacity);
+            throw;
+        }
+        size_t moved = 0;
+        try {
+            for (; moved < count; ++moved) {
+                ::new (static_cast<void*>(newBuffer + moved)) T(std::move_if_noexcept(*slot(moved)));
+            }
+        } catch (...) {
+            for (size_t i = 0; i < moved; ++i) newBuffer[i].~T();
+            p->~T();
+            deallocate(newBuffer, newCapacity);
+            throw;
+        }
+        for (size_t i = 0; i < count; ++i) slot(i)->~T();
+        deallocate(buffer, capacity);
+        buffer = newBuffer;
+        capacity = newCapacity;
+        head = 0;
+        return p;
+    }
+
+public:
+    Queue() = default;
+
+    Queue(const Queue& other) {
+        if (other.count == 0) return;
+        capacity = roundUpToPowerOfTwo(other.count);
+        buffer = allocate(capacity);
+        try {
+            for (; count < other.count; ++count) {
+                ::new (static_cast<void*>(buffer + count)) T(*other.slot(count));
+            }
+        } catch (...) {
+            clear();
+            deallocate(buffer, capacity);
+            throw;
+        }
+    }
+
+    Queue(Queue&& other) noexcept
+        : buffer(other.buffer), capacity(other.capacity), head(other.head), count(other.count) {
+        other.buffer = nullptr;
+        other.capacity = other.head = other.count = 0;
+    }
+
+    Queue& operator=(Queue other) noexcept {
+        std::swap(buffer, other.buffer);
+        std::swap(capacity, other.capacity);
+        std::swap(head, other.head);
+        std::swap(count, other.count);
+        return *this;
+    }
+
+    ~Queue() {
+        clear();
+        deallocate(buffer, capacity);
+    }
+
+    // Метод для добавления элемента в очередь
+    void push(const T& item) {
+        emplace(item);
+    }
+
+    void push(T&& item) {
+        emplace(std::move(item));
+    }
+
+    // Создание элемента прямо в буфере очереди
+    template <typename... Args>
+    T& emplace(Args&&... args) {
+        T* p;
+        if (count == capacity) {
+            p = growAndEmplace(std::forward<Args>(args)...);
+        }
+        else {
+            p = slot(count);
+            ::new (static_cast<void*>(p)) T(std::forward<Args>(args)...);
+        }
+        ++count;
+        return *p;
+    }
+
+    // Метод для удаления элемента из очереди
+    void pop() {
+        if (isEmpty()) {
+            throw std::out_of_range("Queue is empty, cannot pop.");
+        }
+        slot(0)->~T();
+        head = (head + 1) & (capacity - 1);
+        --count;
+    }
+
+    // Извлечение первого элемента без исключений: false, если очередь пуста
+    bool try_pop(T& out) {
+        if (isEmpty()) return false;
+        out = std::move(*slot(0));
+        pop();
+        return true;
+    }
+
+    // Метод для получения первого элемента
+    T& front() {
+        if (isEmpty()) {
+            throw std::out_of_range("Queue is empty, cannot access front.");
+        }
+        return *slot(0);
+    }
+
+    const T& front() const {
+        if (isEmpty()) {
+            throw std::out_of_range("Queue is empty, cannot access front.");
+        }
+        return *slot(0);
+    }
+
+    // Метод для проверки, пуста ли очередь
+    bool isEmpty() const {
+        return count == 0;
+    }
+
+    // Метод для получения размера очереди
+    size_t size() const {
+        return count;
+    }
+
+    void clear() {
+        while (count > 0) {
+            slot(0)->~T();
+            head = (head + 1) & (capacity - 1);
+            --count;
+        }
+        head = 0;
+    }
+};
+
+// Размер кэш-линии, чтобы индексы производителя и потребителя не делили одну линию
+constexpr size_t kCacheLineSize = 64;
+
+// === Ограниченная lock-free очередь: один производитель, один потребитель ===
+template <typename T>
+class SpscQueue {
+private:
+    const size_t capacity;
+    const size_t mask;
+    T* buffer;
+    alignas(kCacheLineSize) std::atomic<size_t> head{0}; // Читает потребитель
+    alignas(kCacheLineSize) std::atomic<size_t> tail{0}; // Пишет производитель
+
+public:
+    explicit SpscQueue(size_t minCapacity)
+        : capacity(roundUpToPowerOfTwo(minCapacity ? minCapacity : 1)),
+          mask(capacity - 1),
+          buffer(std::allocator<T>().allocate(capacity)) {}
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    ~SpscQueue() {
+        size_t h = head.load(std::memory_order_relaxed);
+        size_t t = tail.load(std::memory_order_relaxed);
+        for (; h != t; ++h) buffer[h & mask].~T();
+        std::allocator<T>().deallocate(buffer, capacity);
+    }
+
+    // Добавление элемента: false, если очередь заполнена
+    template <typename... Args>
+    bool try_emplace(Args&&... args) {
+        size_t t = tail.load(std::memory_order_relaxed);
+        if (t - head.load(std::memory_order_acquire) == capacity) return false;
+        ::new (static_cast<void*>(buffer + (t & mask))) T(std::forward<Args>(args)...);
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool try_push(const T& item) { return try_emplace(item); }
+    bool try_push(T&& item) { return try_emplace(std::move(item)); }
+
+    // Извлечение элемента: false, если очередь пуста
+    bool try_pop(T& out) {
+        size_t h = head.load(std::memory_order_relaxed);
+        if (h == tail.load(std::memory_order_acquire)) return false;
+        T& item = buffer[h & mask];
+        out = std::move(item);
+        item.~T();
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    size_t size() const {
+        size_t h = head.load(std::memory_order_acquire);
+        return tail.load(std::memory_order_acquire) - h;
+    }
+
+    bool isEmpty() const { return size() == 0; }
+};
+
+// === Ограниченная lock-free очередь: много производителей, много потребителей ===
+// Каждая ячейка хранит порядковый номер, по которому поток понимает,
+// свободна она для записи или уже готова к чтению.
+template <typename T>
+class MpmcQueue {
+private:
+    struct Cell {
+        std::atomic<size_t> sequence;
+        alignas(T) unsigned char storage[sizeof(T)];
+
+        T* value() { return std::launder(reinterpret_cast<T*>(storage)); }
+    };
+
+    const size_t capacity;
+    const size_t mask;
+    std::unique_ptr<Cell[]> cells;
+    alignas(kCacheLineSize) std::atomic<size_t> enqueuePos{0};
+    alignas(kCacheLineSize) std::atomic<size_t> dequeuePos{0};
+
+public:
+    explicit MpmcQueue(size_t minCapacity)
+        : capacity(roundUpToPowerOfTwo(minCapacity < 2 ? 2 : minCapacity)),
+          mask(capacity - 1),
+          cells(new Cell[capacity]) {
+        for (size_t i = 0; i < capacity; ++i) {
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpmcQueue(const MpmcQueue&) = delete;
+    MpmcQueue& operator=(const MpmcQueue&) = delete;
+
+    ~MpmcQueue() {
+        size_t pos = dequeuePos.load(std::memory_order_relaxed);
+        size_t end = enqueuePos.load(std::memory_order_relaxed);
+        for (; pos != end; ++pos) cells[pos & mask].value()->~T();
+    }
+
+    // Добавление элемента: false, если очередь заполнена
+    template <typename... Args>
+    bool try_emplace(Args&&... args) {
+        size_t pos = enqueuePos.load(std::memory_order_relaxed);
+        Cell* cell;
+        for (;;) {
+            cell = &cells[pos & mask];
+            size_t seq = cell->sequence.load(std::memory_order_acquire);
+            std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+            if (diff == 0) {
+                if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+            }
+            else if (diff < 0) {
+                return false;
+            }
+            else {
+                pos = enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+        ::new (static_cast<void*>(cell->storage)) T(std::forward<Args>(args)...);
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool try_push(const T& item) { return try_emplace(item); }
+    bool try_push(T&& item) { return try_emplace(std::move(item)); }
+
+    // Извлечение элемента: false, если очередь пуста
+    bool try_pop(T& out) {
+        size_t pos = dequeuePos.load(std::memory_order_relaxed);
+        Cell* cell;
+        for (;;) {
+            cell = &cells[pos & mask];
+            size_t seq = cell->sequence.load(std::memory_order_acquire);
+            std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos + 1);
+            if (diff == 0) {
+                if (dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+            }
+            else if (diff < 0) {
+                return false;
+            }
+            else {
+                pos = dequeuePos.load(std::memory_order_relaxed);
+            }
+        }
+        T* item = cell->value();
+        out = std::move(*item);
+        item->~T();
+        cell->sequence.store(pos + mask + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Приблизительный размер (точен, только когда нет одновременных операций)
+    size_t size() const {
+        size_t enq = enqueuePos.load(std::memory_order_acquire);
+        size_t deq = dequeuePos.load(std::memory_order_acquire);
+        return enq >= deq ? enq - deq : 0;
+    }
+
+    bool isEmpty() const { return size() == 0; }
+};
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// === Пул потоков с перехватом работы (work stealing) ===
+// У каждого рабочего потока своя очередь задач: владелец берёт задачи с конца,
+// а простаивающие потоки забирают их с начала чужих очередей.
+// Задача получает индекс потока, чтобы пользоваться его локальным состоянием.
+class WorkStealingPool {
+public:
+    using Task = std::function<void(size_t worker)>;
+
+private:
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues;
+    std::vector<std::thread> threads;
+    std::atomic<std::ptrdiff_t> queued{0}; // Задачи, ещё не взятые потоками (может кратко уйти в минус)
+    std::atomic<size_t> pending{0};        // Задачи, ещё не завершённые
+    std::atomic<size_t> nextQueue{0};
+    bool stopping = false;                 // Защищено idleMutex
+
+    std::mutex idleMutex;
+    std::condition_variable idleCv;
+    std::mutex doneMutex;
+    std::condition_variable doneCv;
+
+    bool popLocal(size_t worker, Task& task) {
+        WorkerQueue& q = *queues[worker];
+        std::lock_guard<std::mutex> lock(q.mutex);
+        if (q.tasks.empty()) return false;
+        task = std::move(q.tasks.back());
+        q.tasks.pop_back();
+        return true;
+    }
+
+    bool steal(size_t thief, Task& task) {
+        for (size_t i = 1; i < queues.size(); ++i) {
+            WorkerQueue& q = *queues[(thief + i) % queues.size()];
+            std::lock_guard<std::mutex> lock(q.mutex);
+            if (!q.tasks.empty()) {
+                task = std::move(q.tasks.front());
+                q.tasks.pop_front();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void workerLoop(size_t worker) {
+        Task task;
+        for (;;) {
+            if (popLocal(worker, task) || steal(worker, task)) {
+                queued.fetch_sub(1, std::memory_order_relaxed);
+                task(worker);
+                task = nullptr;
+                if (pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                    std::lock_guard<std::mutex> lock(doneMutex);
+                    doneCv.notify_all();
+                }
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(idleMutex);
+            idleCv.wait(lock, [this] { return stopping || queued.load(std::memory_order_relaxed) > 0; });
+            if (stopping && queued.load(std::memory_order_relaxed) <= 0) return;
+        }
+    }
+
+public:
+    explicit WorkStealingPool(size_t threadCount = std::thread::hardware_concurrency()) {
+        if (threadCount == 0) threadCount = 1;
+        for (size_t i = 0; i < threadCount; ++i) {
+            queues.push_back(std::make_unique<WorkerQueue>());
+        }
+        for (size_t i = 0; i < threadCount; ++i) {
+            threads.emplace_back(&WorkStealingPool::workerLoop, this, i);
+        }
+    }
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    // Завершение: дожидаемся оставшихся задач и присоединяем потоки
+    ~WorkStealingPool() {
+        wait();
+        {
+            std::lock_guard<std::mutex> lock(idleMutex);
+            stopping = true;
+        }
+        idleCv.notify_all();
+        for (auto& t : threads) t.join();
+    }
+
+    size_t size() const {
+        return threads.size();
+    }
+
+    // Добавление задачи; очереди потоков заполняются по кругу
+    void submit(Task task) {
+        size_t worker = nextQueue.fetch_add(1, std::memory_order_relaxed) % queues.size();
+        pending.fetch_add(1, std::memory_order_relaxed);
+        {
+            WorkerQueue& q = *queues[worker];
+            std::lock_guard<std::mutex> lock(q.mutex);
+            q.tasks.push_back(std::move(task));
+        }
+        {
+            std::lock_guard<std::mutex> lock(idleMutex);
+            queued.fetch_add(1, std::memory_order_relaxed);
+        }
+        idleCv.notify_one();
+    }
+
+    // Ожидание завершения всех отправленных задач
+    void wait() {
+        std::unique_lock<std::mutex> lock(doneMutex);
+        doneCv.wait(lock, [this] { return pending.load(std::memory_order_acquire) == 0; });
+    }
+};
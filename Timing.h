@@ -0,0 +1,164 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
+// === Инструменты замера производительности ===
+
+// Пиковое потребление памяти процессом (МБ), если доступно
+inline double peakMemoryMb() {
+#ifndef _WIN32
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0) return usage.ru_maxrss / 1024.0;
+#endif
+    return 0.0;
+}
+
+// Замер участка кода: при выходе из области видимости прибавляет прошедшее
+// время (мс) к переменной total, а без неё печатает его в stderr
+class ScopedTimer {
+private:
+    using Clock = std::chrono::steady_clock;
+
+    const char* label;
+    double* total;
+    Clock::time_point start;
+
+public:
+    explicit ScopedTimer(const char* label, double* total = nullptr)
+        : label(label), total(total), start(Clock::now()) {}
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+    ~ScopedTimer() {
+        double ms = elapsedMs();
+        if (total) *total += ms;
+        else std::fprintf(stderr, "[timer] %s: %.3f ms\n", label, ms);
+    }
+
+    double elapsedMs() const {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+};
+
+// LB_TIME_SCOPE("название") замеряет участок только в сборке с LB_PROFILE,
+// иначе не оставляет в программе никакого кода
+#define LB_TIME_SCOPE_JOIN2(a, b) a##b
+#define LB_TIME_SCOPE_JOIN(a, b) LB_TIME_SCOPE_JOIN2(a, b)
+#ifdef LB_PROFILE
+#define LB_TIME_SCOPE(label) ScopedTimer LB_TIME_SCOPE_JOIN(scopedTimer, __LINE__)(label)
+#else
+#define LB_TIME_SCOPE(label) ((void)0)
+#endif
+
+// === Аппаратные счётчики процессора (Linux perf_event) ===
+// Такты, инструкции, промахи кэша и ошибки предсказания переходов потока, создавшего
+// счётчики, и всех потоков, запущенных им после этого (пулы, производители очередей,
+// фоновый журнал). Потоки, созданные раньше счётчиков, не учитываются.
+// Если ядро не даёт доступа (perf_event_paranoid, контейнер, не Linux),
+// available() возвращает false, а значения остаются нулевыми.
+class HardwareCounters {
+public:
+    struct Values {
+        uint64_t cycles = 0;
+        uint64_t instructions = 0;
+        uint64_t cacheMisses = 0;
+        uint64_t branchMisses = 0;
+    };
+
+private:
+    static constexpr int kCount = 4;
+    int fds[kCount] = { -1, -1, -1, -1 };
+    uint64_t baseline[kCount] = {};
+    bool opened = false;
+
+    uint64_t readCounter(int i) const {
+        uint64_t value = 0;
+#ifdef __linux__
+        if (::read(fds[i], &value, sizeof(value)) != sizeof(value)) value = 0;
+#endif
+        return value;
+    }
+
+public:
+    HardwareCounters() {
+#ifdef __linux__
+        const uint64_t configs[kCount] = {
+            PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+            PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES
+        };
+        opened = true;
+        for (int i = 0; i < kCount; ++i) {
+            perf_event_attr attr;
+            std::memset(&attr, 0, sizeof(attr));
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.size = sizeof(attr);
+            attr.config = configs[i];
+            attr.disabled = 1;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            attr.inherit = 1; // Учитывать и потоки, созданные после открытия счётчика
+            fds[i] = static_cast<int>(::syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+            opened = opened && fds[i] >= 0;
+        }
+#endif
+    }
+
+    ~HardwareCounters() {
+#ifdef __linux__
+        for (int fd : fds) {
+            if (fd >= 0) ::close(fd);
+        }
+#endif
+    }
+
+    HardwareCounters(const HardwareCounters&) = delete;
+    HardwareCounters& operator=(const HardwareCounters&) = delete;
+
+    bool available() const { return opened; }
+
+    // Сброс не обнуляет накопленное завершившимися потоками, поэтому
+    // результат считается как разность с показаниями на старте
+    void start() {
+#ifdef __linux__
+        if (!opened) return;
+        for (int i = 0; i < kCount; ++i) {
+            ::ioctl(fds[i], PERF_EVENT_IOC_RESET, 0);
+            baseline[i] = readCounter(i);
+        }
+        for (int fd : fds) ::ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+#endif
+    }
+
+    Values stop() {
+        Values values;
+#ifdef __linux__
+        if (!opened) return values;
+        uint64_t raw[kCount] = {};
+        for (int fd : fds) ::ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        for (int i = 0; i < kCount; ++i) {
+            uint64_t value = readCounter(i);
+            raw[i] = value > baseline[i] ? value - baseline[i] : 0;
+        }
+        values.cycles = raw[0];
+        values.instructions = raw[1];
+        values.cacheMisses = raw[2];
+        values.branchMisses = raw[3];
+#endif
+        return values;
+    }
+};
@@ -0,0 +1,565 @@
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "AccessControl.h" // LB_10
+#include "BattleSim.h"     // LB_7.2
+#include "Character.h"     // LB_9
+#include "GameManager.h"   // LB_7.1
+#include "Inventory.h"
+#include "Log.h"
+#include "Queue.h"
+#include "Timing.h"
+
+// === Набор замеров для всех LB_* ===
+// bench [--filter подстрока] [--repeat N] [--warmup N] [--scale K] [--counters] [--out файл] [--list]
+// Каждый замер после прогрева (--warmup, по умолчанию 1) повторяется N раз; результаты выводятся в JSON (stdout или --out),
+// ход выполнения — в stderr. --scale умножает размеры нагрузок, --counters
+// добавляет аппаратные счётчики процессора (Linux perf_event), включая потоки,
+// которые замер запускает сам (пулы, производители и потребители очередей).
+
+struct Options {
+    std::string filter;
+    int repeat = 3;
+    int warmup = 1;
+    double scale = 1.0;
+    bool counters = false;
+    bool list = false;
+    std::string out;
+};
+
+// Один прогон замера; measure() отмечает участок, который входит в результат
+class Sample {
+private:
+    HardwareCounters* counters;
+    double ms = 0.0;
+    HardwareCounters::Values values;
+
+public:
+    // Счётчики включаются до запуска таймера и выключаются после его остановки,
+    // чтобы их системные вызовы не попадали во время замера
+    class Scope {
+    private:
+        Sample& sample;
+        std::optional<ScopedTimer> timer;
+
+    public:
+        explicit Scope(Sample& sample) : sample(sample) {
+            if (sample.counters) sample.counters->start();
+            timer.emplace("sample", &sample.ms);
+        }
+
+        ~Scope() {
+            timer.reset();
+            if (sample.counters) sample.values = sample.counters->stop();
+        }
+    };
+
+    explicit Sample(HardwareCounters* counters) : counters(counters) {}
+
+    Scope measure() { return Scope(*this); }
+
+    double elapsedMs() const { return ms; }
+    const HardwareCounters::Values& counterValues() const { return values; }
+};
+
+struct Result {
+    std::string name;
+    std::vector<std::pair<std::string, double>> params;
+    double items = 0;
+    std::vector<double> samplesMs;
+    bool hasCounters = false;
+    HardwareCounters::Values counters; // Среднее на прогон
+};
+
+using Params = std::vector<std::pair<std::string, double>>;
+
+// Целые значения выводятся без экспоненты (1000000, а не 1e+06)
+std::string formatNumber(double value) {
+    std::ostringstream out;
+    if (value == static_cast<double>(static_cast<long long>(value))) {
+        out << static_cast<long long>(value);
+    }
+    else {
+        out.precision(10);
+        out << value;
+    }
+    return out.str();
+}
+
+class BenchRunner {
+private:
+    Options options;
+    std::vector<Result> results;
+    std::unique_ptr<HardwareCounters> counters;
+
+public:
+    explicit BenchRunner(const Options& options) : options(options) {
+        if (options.counters) {
+            // Открываются до запуска любых рабочих потоков, чтобы те унаследовали счётчики
+            counters = std::make_unique<HardwareCounters>();
+            if (!counters->available()) {
+                std::cerr << "Hardware counters are not available, timing only.\n";
+                counters.reset();
+            }
+        }
+    }
+
+    // Нужна ли группа замеров: фильтр вида "группа/..." позволяет не готовить данные чужих групп
+    bool wants(const std::string& group) const {
+        size_t slash = options.filter.find('/');
+        if (options.list || slash == std::string::npos) return true;
+        return options.filter.compare(0, slash, group) == 0;
+    }
+
+    size_t scaled(size_t n) const {
+        return std::max<size_t>(1, static_cast<size_t>(n * options.scale));
+    }
+
+    // body(Sample&) выполняется options.repeat раз; items — число операций за прогон
+    void run(const std::string& name, const Params& params, double items,
+             const std::function<void(Sample&)>& body) {
+        std::string fullName = name;
+        for (const auto& p : params) {
+            fullName += "/" + p.first + ":" + formatNumber(p.second);
+        }
+        if (options.list) {
+            std::cout << fullName << "\n";
+            return;
+        }
+        if (!options.filter.empty() && fullName.find(options.filter) == std::string::npos) return;
+
+        Result result;
+        result.name = name;
+        result.params = params;
+        result.items = items;
+        result.hasCounters = counters != nullptr;
+        for (int i = 0; i < options.warmup; ++i) {
+            Sample sample(counters.get());
+            body(sample);
+        }
+        for (int i = 0; i < options.repeat; ++i) {
+            Sample sample(counters.get());
+            body(sample);
+            result.samplesMs.push_back(sample.elapsedMs());
+            const auto& v = sample.counterValues();
+            result.counters.cycles += v.cycles / options.repeat;
+            result.counters.instructions += v.instructions / options.repeat;
+            result.counters.cacheMisses += v.cacheMisses / options.repeat;
+            result.counters.branchMisses += v.branchMisses / options.repeat;
+        }
+
+        double best = *std::min_element(result.samplesMs.begin(), result.samplesMs.end());
+        std::cerr << fullName << ": " << best << " ms";
+        if (best > 0) std::cerr << " (" << items / best * 1000.0 << " items/s)";
+        std::cerr << "\n";
+        results.push_back(std::move(result));
+    }
+
+    void writeJson(std::ostream& out) const {
+        out << "{\n  \"context\": {\"date\": " << std::time(nullptr)
+            << ", \"hardware_concurrency\": " << std::thread::hardware_concurrency()
+            << ", \"repeat\": " << options.repeat
+            << ", \"warmup\": " << options.warmup
+            << ", \"scale\": " << options.scale
+            << ", \"counters\": " << (counters ? "true" : "false")
+            << ", \"peak_rss_mb\": " << peakMemoryMb() << "},\n  \"benchmarks\": [";
+        for (size_t i = 0; i < results.size(); ++i) {
+            const Result& r = results[i];
+            double best = *std::min_element(r.samplesMs.begin(), r.samplesMs.end());
+            double worst = *std::max_element(r.samplesMs.begin(), r.samplesMs.end());
+            double mean = 0;
+            for (double ms : r.samplesMs) mean += ms;
+            mean /= r.samplesMs.size();
+
+            out << (i ? ",\n" : "\n") << "    {\"name\": \"" << r.name << "\", \"params\": {";
+            for (size_t p = 0; p < r.params.size(); ++p) {
+                out << (p ? ", " : "") << "\"" << r.params[p].first << "\": " << formatNumber(r.params[p].second);
+            }
+            out << "}, \"items\": " << formatNumber(r.items)
+                << ", \"min_ms\": " << formatNumber(best)
+                << ", \"mean_ms\": " << formatNumber(mean)
+                << ", \"max_ms\": " << formatNumber(worst)
+                << ", \"items_per_second\": " << formatNumber(best > 0 ? r.items / best * 1000.0 : 0.0);
+            if (r.hasCounters) {
+                out << ", \"counters\": {\"cycles\": " << r.counters.cycles
+                    << ", \"instructions\": " << r.counters.instructions
+                    << ", \"cache_misses\": " << r.counters.cacheMisses
+                    << ", \"branch_misses\": " << r.counters.branchMisses << "}";
+            }
+            out << "}";
+        }
+        out << "\n  ]\n}\n";
+    }
+};
+
+// Вывод программ (сообщения о сохранении и т. п.) на время замеров отключается,
+// чтобы не смешиваться с JSON
+class SilenceCout {
+private:
+    std::streambuf* saved;
+
+public:
+    SilenceCout() : saved(std::cout.rdbuf(nullptr)) {}
+    ~SilenceCout() { std::cout.rdbuf(saved); }
+};
+
+// Временные файлы замеров
+const char* const kTempText = "bench_tmp.txt";
+const char* const kTempBinary = "bench_tmp.bin";
+const char* const kTempJournal = "bench_tmp.journal";
+
+void removeTempFiles() {
+    for (const char* name : { kTempText, kTempBinary, kTempJournal }) {
+        std::remove(name);
+        std::remove((std::string(name) + ".tmp").c_str());
+    }
+}
+
+// ===== Очереди (Queue.h) =====
+
+// Старая реализация очереди на векторе (удаление через erase(begin())) — для сравнения
+template <typename T>
+class VectorQueue {
+private:
+    std::vector<T> items;
+
+public:
+    void push(const T& item) { items.push_back(item); }
+    void pop() { items.erase(items.begin()); }
+    const T& front() const { return items.front(); }
+    bool isEmpty() const { return items.empty(); }
+};
+
+// Передача n чисел от producers потоков одному потребителю
+template <typename Q>
+uint64_t crossThread(Q& q, size_t n, size_t producers) {
+    size_t perProducer = n / producers;
+    std::vector<std::thread> threads;
+    for (size_t p = 0; p < producers; ++p) {
+        threads.emplace_back([&q, p, perProducer] {
+            for (size_t i = 0; i < perProducer; ++i) {
+                while (!q.try_push(p * perProducer + i)) std::this_thread::yield();
+            }
+        });
+    }
+    uint64_t total = 0;
+    uint64_t item;
+    for (size_t received = 0; received < perProducer * producers;) {
+        if (q.try_pop(item)) {
+            total += item;
+            ++received;
+        }
+        else {
+            std::this_thread::yield();
+        }
+    }
+    for (auto& t : threads) t.join();
+    return total;
+}
+
+void benchQueues(BenchRunner& runner) {
+    if (!runner.wants("queue")) return;
+    volatile uint64_t sink = 0;
+    for (size_t base : { 1000, 100000, 1000000 }) {
+        size_t n = runner.scaled(base);
+        runner.run("queue/ring_push_pop", { { "n", double(n) } }, double(n), [&](Sample& sample) {
+            Queue<uint64_t> q;
+            auto scope = sample.measure();
+            for (size_t i = 0; i < n; ++i) q.push(i);
+            uint64_t item, total = 0;
+            while (q.try_pop(item)) total += item;
+            sink = sink + total;
+        });
+        // erase(begin()) квадратичен — ограничиваемся небольшими размерами
+        if (n <= 100000) {
+            runner.run("queue/vector_erase", { { "n", double(n) } }, double(n), [&](Sample& sample) {
+                VectorQueue<uint64_t> q;
+                auto scope = sample.measure();
+                for (size_t i = 0; i < n; ++i) q.push(i);
+                uint64_t total = 0;
+                while (!q.isEmpty()) {
+                    total += q.front();
+                    q.pop();
+                }
+                sink = sink + total;
+            });
+        }
+        runner.run("queue/spsc_1p1c", { { "n", double(n) } }, double(n), [&](Sample& sample) {
+            SpscQueue<uint64_t> q(1024);
+            auto scope = sample.measure();
+            sink = sink + crossThread(q, n, 1);
+        });
+        runner.run("queue/mpmc_4p1c", { { "n", double(n) } }, double(n), [&](Sample& sample) {
+            MpmcQueue<uint64_t> q(1024);
+            auto scope = sample.measure();
+            sink = sink + crossThread(q, n, 4);
+        });
+    }
+}
+
+// ===== Инвентарь (Inventory.h) =====
+
+void benchInventory(BenchRunner& runner) {
+    if (!runner.wants("inventory")) return;
+    size_t n = runner.scaled(1000000);
+    for (size_t distinct : { 16, 1024 }) {
+        std::vector<std::string> names;
+        for (size_t i = 0; i < distinct; ++i) names.push_back("Предмет номер " + std::to_string(i));
+
+        runner.run("inventory/add_remove", { { "ops", double(n) }, { "distinct", double(distinct) } }, double(2 * n),
+                   [&](Sample& sample) {
+            Inventory<std::string> inventory(false);
+            auto scope = sample.measure();
+            for (size_t i = 0; i < n; ++i) inventory.addItem(names[i % distinct]);
+            for (size_t i = 0; i < n; ++i) inventory.removeItem(names[i % distinct]);
+        });
+    }
+}
+
+// ===== Контроль доступа (LB_10) =====
+
+void fillAccessSystem(AccessControlSystem<User>& system, size_t userCount, size_t resourceCount) {
+    for (size_t i = 0; i < userCount; ++i) {
+        int id = static_cast<int>(i);
+        std::string name = "Пользователь " + std::to_string(i);
+        switch (i % 3) {
+        case 0: system.addUser(std::make_shared<Student>(name, id, id % 11, "CS-" + std::to_string(i % 500))); break;
+        case 1: system.addUser(std::make_shared<Teacher>(name, id, id % 11, "Кафедра-" + std::to_string(i % 40))); break;
+        default: system.addUser(std::make_shared<Administrator>(name, id, id % 11)); break;
+        }
+    }
+    for (size_t i = 0; i < resourceCount; ++i) {
+        system.addResource(Resource("Ресурс " + std::to_string(i), static_cast<int>(i % 11)));
+    }
+}
+
+void benchAccessControl(BenchRunner& runner) {
+    if (!runner.wants("acl")) return;
+    const size_t resourceCount = 1000;
+    volatile size_t sink = 0;
+    for (size_t base : { 10000, 100000 }) {
+        size_t users = runner.scaled(base);
+        AccessControlSystem<User> system;
+        fillAccessSystem(system, users, resourceCount);
+        Params params = { { "users", double(users) }, { "resources", double(resourceCount) } };
+
+        runner.run("acl/find_user_by_id", params, double(users), [&](Sample& sample) {
+            auto scope = sample.measure();
+            for (size_t i = 0; i < users; ++i) {
+                sink = sink + (system.findUserById(static_cast<int>((i * 7919) % users)) != nullptr);
+            }
+        });
+
+        std::vector<std::string> names;
+        for (size_t i = 0; i < users; ++i) names.push_back("Пользователь " + std::to_string((i * 7919) % users));
+        runner.run("acl/find_user_exact", params, double(users), [&](Sample& sample) {
+            auto scope = sample.measure();
+            for (const auto& name : names) sink = sink + system.findUserExact(name).size();
+        });
+
+        std::vector<AccessRequest> requests;
+        for (size_t i = 0; i < users; ++i) {
+            requests.push_back({ static_cast<int>(i), "Ресурс " + std::to_string(i % resourceCount) });
+        }
+        runner.run("acl/check_access_batch", params, double(users), [&](Sample& sample) {
+            auto scope = sample.measure();
+            sink = sink + system.checkAccessBatch(requests).size();
+        });
+
+        runner.run("acl/build_matrix", params, double(users) * resourceCount, [&](Sample& sample) {
+            auto scope = sample.measure();
+            AccessMatrix matrix = system.buildAccessMatrix();
+            sink = sink + matrix.get(0, 0);
+        });
+    }
+}
+
+// ===== Сохранение и загрузка =====
+
+void benchGameManager(BenchRunner& runner) {
+    if (!runner.wants("lb7.1")) return;
+    size_t n = runner.scaled(1000000);
+    Params params = { { "entities", double(n) } };
+    const char* names[] = { "Hero", "Mage", "Warrior", "Rogue", "Paladin" };
+
+    GameManager<Player> manager;
+    manager.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        manager.addEntity(names[i % 5], static_cast<int>(50 + i % 100), static_cast<int>(1 + i % 60));
+    }
+    runner.run("lb7.1/save", params, double(n), [&](Sample& sample) {
+        auto scope = sample.measure();
+        saveToFile(manager, kTempText);
+    });
+    runner.run("lb7.1/load", params, double(n), [&](Sample& sample) {
+        GameManager<Player> loaded;
+        {
+            auto scope = sample.measure();
+            loadFromFile(loaded, kTempText);
+        }
+    });
+    removeTempFiles();
+}
+
+void benchCharacter(BenchRunner& runner) {
+    if (!runner.wants("lb9")) return;
+    size_t items = runner.scaled(100000);
+    Params params = { { "items", double(items) } };
+
+    Character hero("Герой", 100, 10, 5);
+    hero.inventory.setLogging(false);
+    for (size_t i = 0; i < items; ++i) hero.inventory.addItem("Предмет " + std::to_string(i % 1000));
+
+    runner.run("lb9/save", params, double(items), [&](Sample& sample) {
+        SilenceCout silence;
+        auto scope = sample.measure();
+        hero.saveToFile(kTempText);
+    });
+    runner.run("lb9/load", params, double(items), [&](Sample& sample) {
+        SilenceCout silence;
+        Character loaded;
+        loaded.inventory.setLogging(false);
+        auto scope = sample.measure();
+        loaded.loadFromFile(kTempText);
+    });
+    removeTempFiles();
+
+    // Журнал: каждое изменение характеристик — запись, затем метка сохранения
+    size_t changes = runner.scaled(100000);
+    runner.run("lb9/journal_changes", { { "changes", double(changes) } }, double(changes), [&](Sample& sample) {
+        SilenceCout silence;
+        Character player("Герой", 100, 10, 5);
+        SaveJournal journal(kTempText, kTempJournal);
+        journal.start(player);
+        {
+            auto scope = sample.measure();
+            for (size_t i = 0; i < changes; ++i) player.heal(i % 2 ? 1 : -1);
+            journal.commit();
+            journal.flush();
+        }
+        journal.close();
+        player.attachJournal(nullptr);
+    });
+    removeTempFiles();
+}
+
+void benchAccessStorage(BenchRunner& runner) {
+    if (!runner.wants("lb10")) return;
+    size_t users = runner.scaled(100000);
+    Params params = { { "users", double(users) }, { "resources", 1000.0 } };
+    AccessControlSystem<User> system;
+    fillAccessSystem(system, users, 1000);
+
+    runner.run("lb10/text_save", params, double(users), [&](Sample& sample) {
+        SilenceCout silence;
+        auto scope = sample.measure();
+        system.saveToFile(kTempText);
+    });
+    runner.run("lb10/text_load", params, double(users), [&](Sample& sample) {
+        SilenceCout silence;
+        AccessControlSystem<User> loaded;
+        auto scope = sample.measure();
+        loaded.loadFromFile(kTempText);
+    });
+    runner.run("lb10/snapshot_save", params, double(users), [&](Sample& sample) {
+        auto scope = sample.measure();
+        system.saveSnapshot(kTempBinary);
+    });
+    runner.run("lb10/snapshot_load", params, double(users), [&](Sample& sample) {
+        AccessControlSystem<User> loaded;
+        auto scope = sample.measure();
+        loaded.loadSnapshot(kTempBinary);
+    });
+    removeTempFiles();
+}
+
+// ===== Бои (LB_7.2) =====
+
+void benchBattles(BenchRunner& runner) {
+    if (!runner.wants("battles")) return;
+    uint64_t battles = runner.scaled(1000000);
+    std::vector<size_t> threadCounts = { 1 };
+    size_t hardware = std::max(1u, std::thread::hardware_concurrency());
+    if (hardware > 1) threadCounts.push_back(hardware);
+
+    for (size_t threads : threadCounts) {
+        runner.run("battles/simulate", { { "battles", double(battles) }, { "threads", double(threads) } },
+                   double(battles), [&](Sample& sample) {
+            auto scope = sample.measure();
+            runSimulation(battles, threads, 42);
+        });
+    }
+}
+
+int main(int argc, char* argv[]) {
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        auto value = [&]() -> std::string {
+            if (i + 1 >= argc) throw std::invalid_argument("Missing value for " + arg);
+            return argv[++i];
+        };
+        try {
+            if (arg == "--filter") options.filter = value();
+            else if (arg == "--repeat") options.repeat = std::max(1, std::atoi(value().c_str()));
+            else if (arg == "--warmup") options.warmup = std::max(0, std::atoi(value().c_str()));
+            else if (arg == "--scale") options.scale = std::atof(value().c_str());
+            else if (arg == "--out") options.out = value();
+            else if (arg == "--counters") options.counters = true;
+            else if (arg == "--list") options.list = true;
+            else throw std::invalid_argument("Unknown option " + arg);
+        }
+        catch (const std::exception& e) {
+            std::cerr << "Error: " << e.what() << "\n"
+                      << "Usage: bench [--filter S] [--repeat N] [--warmup N] [--scale K] [--counters] [--out FILE] [--list]\n";
+            return 1;
+        }
+    }
+    if (options.scale <= 0) options.scale = 1.0;
+
+    gamelog::setLevel(gamelog::Level::Off); // Журнал событий не должен влиять на замеры
+
+    BenchRunner runner(options);
+    try {
+        benchQueues(runner);
+        benchInventory(runner);
+        benchAccessControl(runner);
+        benchGameManager(runner);
+        benchCharacter(runner);
+        benchAccessStorage(runner);
+        benchBattles(runner);
+    }
+    catch (const std::exception& e) {
+        removeTempFiles();
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+    if (options.list) return 0;
+
+    if (options.out.empty()) {
+        runner.writeJson(std::cout);
+    }
+    else {
+        std::ofstream out(options.out);
+        if (!out) {
+            std::cerr << "Error: cannot open " << options.out << "\n";
+            return 1;
+        }
+        runner.writeJson(out);
+    }
+    return 0;
+}